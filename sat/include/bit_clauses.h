@@ -0,0 +1,247 @@
+// bit_clauses.h
+// Bit-parallel clause representation for problems with few variables. A
+// clause is a pair of fixed-width bit vectors holding its positive and
+// negative literals, so resolution becomes a handful of word operations on
+// whole clauses.
+
+#ifndef BIT_CLAUSES_H
+#define BIT_CLAUSES_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "clauses.h"
+
+// largest number of variables handled by bit clauses
+const int max_bit_vars = 256;
+
+// clause over variables 1 .. 64 * W, variable v is stored in bit v - 1
+template <int W>
+struct bit_clause
+{
+    uint64_t pos[W];
+    uint64_t neg[W];
+
+    bit_clause(void)
+    {
+        for (int i = 0; i < W; i++) {
+            pos[i] = 0;
+            neg[i] = 0;
+        }
+    }
+
+    explicit bit_clause(const clause_t& clause)
+    {
+        for (int i = 0; i < W; i++) {
+            pos[i] = 0;
+            neg[i] = 0;
+        }
+        for (const literal_t& lit : clause) {
+            proposition_t var = std::get<0>(lit) - 1;
+            if (var >= 64 * W) {
+                throw "Variable does not fit into bit clause";
+            }
+            uint64_t bit = uint64_t(1) << (var % 64);
+            if (std::get<1>(lit)) {
+                pos[var / 64] |= bit;
+            } else {
+                neg[var / 64] |= bit;
+            }
+        }
+    }
+
+    // conversion back to the generic representation, visiting set bits only
+    clause_t to_clause(void) const
+    {
+        clause_t clause;
+        for (int i = 0; i < W; i++) {
+            for (uint64_t w = pos[i]; w; w &= w - 1) {
+                clause.insert(literal_t(64 * i + __builtin_ctzll(w) + 1, true));
+            }
+            for (uint64_t w = neg[i]; w; w &= w - 1) {
+                clause.insert(literal_t(64 * i + __builtin_ctzll(w) + 1,
+                                        false));
+            }
+        }
+        return clause;
+    }
+};
+
+// Number of variables both clauses contain with opposite signs, only exact
+// for the values 0, 1 and 2, which are all the caller needs. The clashing bits
+// of the last clashing word are stored in clash.
+template <int W>
+int clash_count(const bit_clause<W>& clause_a, const bit_clause<W>& clause_b,
+                int& word, uint64_t& clash)
+{
+    int cnt = 0;
+    for (int i = 0; i < W; i++) {
+        uint64_t c = (clause_a.pos[i] & clause_b.neg[i])
+                   | (clause_a.neg[i] & clause_b.pos[i]);
+        if (c) {
+            word = i;
+            clash = c;
+            cnt += (c & (c - 1)) ? 2 : 1;
+        }
+    }
+    return cnt;
+}
+
+// Resolution of two clauses clashing on exactly the variable selected by the
+// bit in the given word, upon its positive literal in the first clause if
+// positive is set. Clauses clashing on more variables only produce
+// tautologies, so the caller does not resolve them at all. Only the literal
+// resolved upon leaves each clause, as a parent may be a tautology itself.
+// Returns false if the resolvent is a tautology.
+template <int W>
+bool resolve_bits(const bit_clause<W>& clause_a, const bit_clause<W>& clause_b,
+                  int word, uint64_t bit, bool positive,
+                  bit_clause<W>& new_clause)
+{
+    for (int i = 0; i < W; i++) {
+        new_clause.pos[i] = clause_a.pos[i] | clause_b.pos[i];
+        new_clause.neg[i] = clause_a.neg[i] | clause_b.neg[i];
+    }
+    if (positive) {
+        new_clause.pos[word] = (clause_a.pos[word] & ~bit) | clause_b.pos[word];
+        new_clause.neg[word] = clause_a.neg[word] | (clause_b.neg[word] & ~bit);
+    } else {
+        new_clause.pos[word] = clause_a.pos[word] | (clause_b.pos[word] & ~bit);
+        new_clause.neg[word] = (clause_a.neg[word] & ~bit) | clause_b.neg[word];
+    }
+    uint64_t both = 0;
+    for (int i = 0; i < W; i++) {
+        both |= new_clause.pos[i] & new_clause.neg[i];
+    }
+    return both == 0;
+}
+
+// Generation step of a generic given clause algorithm using the bit kernels.
+// The given clause is resolved with bit copies of the processed clauses, each
+// paired with its generic original, and the resolvents are stored as generic
+// clauses.
+template <int W, class Simplify, class Trace, class Order>
+void generate_resolvents(
+    const clause_t& clause,
+    const std::vector<std::pair<bit_clause<W>, const clause_t*> >& processed_bits,
+    const clause_set_t& processed, clause_set_t& unprocessed,
+    Simplify& simplification, Trace& trace, Order& order)
+{
+    bit_clause<W> given(clause);
+    bit_clause<W> bits_res;
+    clause_t clause_res;
+    int word = 0;
+    uint64_t clash = 0;
+    for (const std::pair<bit_clause<W>, const clause_t*>& proc : processed_bits) {
+        // resolution on one variable, any other clash gives a tautology
+        if (clash_count(given, proc.first, word, clash) != 1) {
+            continue;
+        }
+        // a tautological clause may clash in both directions, then either
+        // resolvent is a tautology as well
+        literal_t lit(64 * word + __builtin_ctzll(clash) + 1,
+                      (given.pos[word] & proc.first.neg[word] & clash) != 0);
+        literal_t opp_lit(std::get<0>(lit), !std::get<1>(lit));
+        if (!order.eligible(clause, lit) ||
+            !order.eligible(*proc.second, opp_lit)) {
+            continue;
+        }
+        if (!resolve_bits(given, proc.first, word, clash, std::get<1>(lit),
+                          bits_res)) {
+            continue;
+        }
+        clause_res = bits_res.to_clause();
+        if (processed.find(clause_res) == processed.end() &&
+            unprocessed.find(clause_res) == unprocessed.end() &&
+            simplification.keep(clause_res, processed)) {
+            trace.resolvent(clause, *proc.second, lit,
+                            *unprocessed.insert(clause_res).first);
+        }
+    }
+}
+
+// Bit copies of the processed clauses of a generic given clause algorithm,
+// in the narrowest width holding the given number of variables, so that its
+// generation step runs on the bit kernels. If a clause uses a variable above
+// that number the copies are dropped and generic generation is used.
+class processed_bits
+{
+    private:
+        int words;
+        std::vector<std::pair<bit_clause<1>, const clause_t*> > bits_1;
+        std::vector<std::pair<bit_clause<2>, const clause_t*> > bits_2;
+        std::vector<std::pair<bit_clause<4>, const clause_t*> > bits_4;
+        template <int W>
+        void add_to(std::vector<std::pair<bit_clause<W>, const clause_t*> >& bits,
+                    const clause_t& clause)
+        {
+            bits.push_back(std::make_pair(bit_clause<W>(clause), &clause));
+        }
+    public:
+        // bit copies for up to vars variables, none for vars <= 0 or above
+        // max_bit_vars
+        processed_bits(int vars = 0)
+        {
+            set_variables(vars);
+        }
+        void set_variables(int vars)
+        {
+            words = vars <= 0 ? 0 : vars <= 64 ? 1 : vars <= 128 ? 2
+                  : vars <= max_bit_vars ? 4 : 0;
+            bits_1.clear();
+            bits_2.clear();
+            bits_4.clear();
+        }
+        bool active(void) const
+        {
+            return words != 0;
+        }
+        // copy a clause just inserted into the processed set, the pointer to
+        // it has to stay valid
+        void add(const clause_t& clause)
+        {
+            try {
+                switch (words) {
+                    case 1: add_to(bits_1, clause); break;
+                    case 2: add_to(bits_2, clause); break;
+                    case 4: add_to(bits_4, clause); break;
+                }
+            } catch (const char*) {
+                set_variables(0);
+            }
+        }
+        template <class Simplify, class Trace, class Order>
+        void generate(const clause_t& clause, const clause_set_t& processed,
+                      clause_set_t& unprocessed, Simplify& simplification,
+                      Trace& trace, Order& order)
+        {
+            switch (words) {
+                case 1:
+                    generate_resolvents(clause, bits_1, processed, unprocessed,
+                                        simplification, trace, order);
+                    break;
+                case 2:
+                    generate_resolvents(clause, bits_2, processed, unprocessed,
+                                        simplification, trace, order);
+                    break;
+                case 4:
+                    generate_resolvents(clause, bits_4, processed, unprocessed,
+                                        simplification, trace, order);
+                    break;
+            }
+        }
+};
+
+// largest variable occurring in a clause set
+inline proposition_t max_variable(const clause_set_t& clauses)
+{
+    proposition_t max_var = 0;
+    for (const clause_t& clause : clauses) {
+        if (!clause.empty() && std::get<0>(*clause.rbegin()) > max_var) {
+            max_var = std::get<0>(*clause.rbegin());
+        }
+    }
+    return max_var;
+}
+
+#endif
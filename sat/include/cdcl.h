@@ -0,0 +1,88 @@
+// cdcl.h
+// Conflict-driven clause learning search, which complements the resolution
+// algorithms: it finds models of satisfiable problems and refutes the others.
+
+#ifndef CDCL_H
+#define CDCL_H
+
+#include <vector>
+#include "clauses.h"
+
+// outcome of a search
+enum cdcl_result { cdcl_sat, cdcl_unsat, cdcl_unknown };
+
+// CDCL solver with two watched literals, VSIDS, phase saving, Luby restarts
+// and periodic reduction of the learned clauses
+class cdcl_solver
+{
+    private:
+        // literals are coded as 2 * variable + negative, variables from 1
+        struct clause_rec
+        {
+            std::vector<int> lits;
+            bool learnt;
+            bool deleted;
+            double activity;
+        };
+        int var_cnt;
+        bool trivially_unsat;
+        std::vector<clause_rec> clauses;
+        // clauses watching a literal, visited when it becomes false
+        std::vector<std::vector<int> > watches;
+        // per variable: value (-1 unassigned, 0 false, 1 true), decision
+        // level, reason clause (-1 for decisions), saved phase, activity
+        std::vector<int> value;
+        std::vector<int> level;
+        std::vector<int> reason;
+        std::vector<bool> phase;
+        std::vector<double> activity;
+        double var_inc;
+        double clause_inc;
+        // binary heap of variables ordered by activity
+        std::vector<int> heap;
+        std::vector<int> heap_pos;
+        // assignment trail, start of every decision level and the position
+        // of the next literal to propagate
+        std::vector<int> trail;
+        std::vector<int> trail_lim;
+        size_t prop_head;
+        // marks of variables during conflict analysis
+        std::vector<char> seen;
+        // statistics
+        long conflicts;
+        long decisions;
+        long propagations;
+        int learnt_cnt;
+        // helper methods
+        int lit_value(int) const;
+        void assign(int, int);
+        int propagate(void);
+        void analyze(int, std::vector<int>&, int&);
+        void backtrack(int);
+        void add_clause(std::vector<int>&, bool);
+        void bump_var(int);
+        void bump_clause(int);
+        void reduce_learnts(void);
+        int pick_branch(void);
+        void heap_up(int);
+        void heap_down(int);
+        void heap_insert(int);
+        int heap_pop(void);
+    public:
+        // constructor, takes the problem and the number of variables, 0 to
+        // derive it from the clauses
+        cdcl_solver(const clause_set_t&, int = 0);
+        // search until the problem is decided or the number of conflicts
+        // exceeds the limit, negative for no limit
+        cdcl_result solve(long = -1);
+        // satisfying assignment after cdcl_sat, indexed by variable
+        std::vector<bool> get_model(void) const;
+        long get_conflicts(void) const { return conflicts; }
+        long get_decisions(void) const { return decisions; }
+        long get_propagations(void) const { return propagations; }
+};
+
+// does the assignment satisfy every clause?
+bool check_model(const clause_set_t&, const std::vector<bool>&);
+
+#endif
@@ -1,6 +1,9 @@
 // clauses.h
 // Definitions of all relevant clause and literal types
 
+#ifndef CLAUSES_H
+#define CLAUSES_H
+
 #include <set>
 #include <utility>
 
@@ -9,3 +12,5 @@ typedef unsigned int proposition_t;
 typedef std::pair<proposition_t, bool> literal_t;
 typedef std::set<literal_t> clause_t;
 typedef std::set<clause_t> clause_set_t;
+
+#endif
@@ -0,0 +1,58 @@
+// frozen_net.h
+// Inference-only copy of a trained neural_net. Weights are stored in single
+// precision or quantized to 8 bits, the sigmoid is replaced by a cheap
+// rational approximation and both layers are evaluated in one pass, which is
+// enough for ranking clauses by their estimated value. The 8-bit weights
+// are a storage format only: they are widened to float for every product, so
+// they save memory but are not faster than the single precision copy, and
+// they are not offered as a precision of clause scoring.
+
+#ifndef FROZEN_NET_H
+#define FROZEN_NET_H
+
+#include <cstdint>
+#include <vector>
+#include "neural_net.h"
+
+// precision used to evaluate a Q-function estimate
+enum inference_t { infer_double, infer_float };
+
+class frozen_net
+{
+    private:
+        // number of neurons in every layer
+        int input_cnt;
+        int hidden_cnt;
+        int output_cnt;
+        bool quantized;
+        // weights, row-major, either in single precision or quantized with
+        // one scale per neuron
+        std::vector<float> hidden_weights;
+        std::vector<float> output_weights;
+        std::vector<int8_t> hidden_weights_q;
+        std::vector<int8_t> output_weights_q;
+        std::vector<float> hidden_scale;
+        std::vector<float> output_scale;
+        std::vector<float> hidden_bias;
+        std::vector<float> output_bias;
+        // internal values
+        std::vector<float> hidden_base;
+        std::vector<float> hidden_values;
+        std::vector<float> outputs;
+        // helper methods, weighted sum of a part of a row of hidden weights
+        // and the output of the first neuron from hidden inputs
+        float hidden_sum(int, int, int, const float*);
+        float first_output(void);
+    public:
+        // empty network, to be assigned later
+        frozen_net(void);
+        // copy of a trained network, quantized if requested
+        frozen_net(const neural_net&, bool);
+        // compute outputs of the network
+        const std::vector<float>& feed_forward(const float*);
+        // first output for count inputs sharing their leading state values,
+        // each action holds the remaining input values
+        void score_actions(const float*, int, const float*, int, float*);
+};
+
+#endif
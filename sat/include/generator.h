@@ -0,0 +1,26 @@
+// generator.h
+// In-process generators of seeded, reproducible benchmark clause sets
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <vector>
+#include "clauses.h"
+
+// uniform random k-SAT: round(ratio * vars) distinct clauses, each over k
+// distinct variables with random polarities
+clause_set_t gen_random_ksat(int vars, int k, double ratio, unsigned int seed);
+
+// pigeonhole principle PHP(holes + 1, holes), always unsatisfiable
+clause_set_t gen_pigeonhole(int holes);
+
+// parity chain x1 xor ... xor xn = b, encoded with auxiliary variables; if
+// unsat is set, a second chain over a shuffled variable order asserts !b
+clause_set_t gen_parity_chain(int vars, bool unsat, unsigned int seed);
+
+// random k-SAT with a planted solution, every clause is satisfied by a hidden
+// random assignment, which is stored in model (indexed by variable) if given
+clause_set_t gen_planted_ksat(int vars, int k, double ratio, unsigned int seed,
+                              std::vector<bool>* model = 0);
+
+#endif
@@ -0,0 +1,502 @@
+// given_clause.h
+// Policy-based given clause algorithm. Clause selection, rejection and
+// simplification are template parameters, so the main loop is specialized
+// for every combination of heuristics and no virtual calls are made. The
+// clause set type is a parameter as well, policies work with any ordered set
+// of clauses providing size() and empty().
+
+#ifndef GIVEN_CLAUSE_H
+#define GIVEN_CLAUSE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "clauses.h"
+
+// Propositional resolution of two clauses upon a literal of the first one,
+// the resolvent is the first clause without the literal joined with the
+// second one without its complement. A parent may be a tautology itself, so
+// only the literal resolved upon is dropped from each. Returns false if the
+// resolvent would be a tautology, in which case it is of no use
+inline bool resolve_clauses(const clause_t& clause_a, const clause_t& clause_b,
+                            const literal_t& lit_res, clause_t& new_clause)
+{
+    // first clause contains the appropriate literal?
+    assert(clause_a.find(lit_res) != clause_a.end());
+    literal_t opp_res(std::get<0>(lit_res), !(std::get<1>(lit_res)));
+    new_clause.clear();
+    // copy literals from the two clauses, while avoiding duplicates
+    // inefficient with current implementation, consider different way of
+    // representing clauses
+    for (const literal_t& lit : clause_a) {
+        if (lit != lit_res) {
+            // the complement of lit_res is the only literal left out of the
+            // second clause, and it can not be the complement of lit
+            literal_t opp_lit(std::get<0>(lit), !(std::get<1>(lit)));
+            if (clause_b.find(opp_lit) != clause_b.end()) {
+                return false;
+            }
+            new_clause.insert(lit);
+        }
+    }
+    for (const literal_t& lit : clause_b) {
+        if (lit != opp_res) {
+            new_clause.insert(lit);
+        }
+    }
+    return true;
+}
+
+// Does the first clause subsume the second one?
+inline bool subsumes(const clause_t& clause_a, const clause_t& clause_b)
+{
+    return clause_a.size() <= clause_b.size() &&
+           std::includes(clause_b.begin(), clause_b.end(),
+                         clause_a.begin(), clause_a.end());
+}
+
+// trace of generated clauses that records nothing
+struct no_trace
+{
+    template <class Clause, class Literal>
+    void resolvent(const Clause&, const Clause&, const Literal&, const Clause&)
+    {
+    }
+};
+
+// ordering policy: every literal may be resolved upon
+struct order_none
+{
+    template <class Clause, class Literal>
+    bool eligible(const Clause&, const Literal&)
+    {
+        return true;
+    }
+};
+
+// ordering policy for ordered resolution: a literal may only be resolved upon
+// if its atom is maximal in the clause. Atoms are compared by their rank,
+// given by the variable, an atom without a rank is ranked by its variable
+struct order_atoms
+{
+    std::vector<proposition_t> rank;
+    order_atoms(void) {}
+    order_atoms(const std::vector<proposition_t>& ranks) : rank(ranks) {}
+    proposition_t rank_of(proposition_t var) const
+    {
+        return var < rank.size() ? rank[var] : var;
+    }
+    bool eligible(const clause_t& clause, const literal_t& lit)
+    {
+        if (rank.empty()) {
+            return std::get<0>(lit) == std::get<0>(*clause.rbegin());
+        }
+        proposition_t lit_rank = rank_of(std::get<0>(lit));
+        for (const literal_t& other : clause) {
+            if (rank_of(std::get<0>(other)) > lit_rank) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Generation step of the given clause algorithm. The clause is resolved with
+// every processed clause upon every literal the ordering policy allows in
+// both parents, new resolvents accepted by the simplification policy are
+// added to the unprocessed clauses and reported to the trace together with
+// their parents and the literal resolved upon. The trace gets the clauses as
+// stored in the sets, so it may keep data by their address.
+template <class Simplify, class Trace, class Order>
+void generate_resolvents(const clause_t& clause, const clause_set_t& processed,
+                         clause_set_t& unprocessed, Simplify& simplification,
+                         Trace& trace, Order& order)
+{
+    // new clauses getting build
+    clause_t clause_res;
+    // iterate over all literals in clause
+    for (const literal_t& lit : clause) {
+        if (!order.eligible(clause, lit)) {
+            continue;
+        }
+        literal_t opp_lit(std::get<0>(lit), !(std::get<1>(lit)));
+        // iterate over all processed clauses
+        for (const clause_t& proc : processed) {
+            // can this resolution be performed?
+            if (proc.find(opp_lit) != proc.end() &&
+                order.eligible(proc, opp_lit) &&
+                resolve_clauses(clause, proc, lit, clause_res)) {
+                // is this a clause we have not seen before?
+                if (processed.find(clause_res) == processed.end() &&
+                    unprocessed.find(clause_res) == unprocessed.end() &&
+                    simplification.keep(clause_res, processed)) {
+                    trace.resolvent(clause, proc, lit,
+                                    *unprocessed.insert(clause_res).first);
+                }
+            }
+        }
+    }
+}
+
+// Generation step resolving upon every literal
+template <class Simplify, class Trace>
+void generate_resolvents(const clause_t& clause, const clause_set_t& processed,
+                         clause_set_t& unprocessed, Simplify& simplification,
+                         Trace& trace)
+{
+    order_none order;
+    generate_resolvents(clause, processed, unprocessed, simplification, trace,
+                        order);
+}
+
+// Remove a selected clause from the unprocessed clauses and return it
+template <class ClauseSet>
+typename ClauseSet::value_type take_clause(ClauseSet& unprocessed,
+                                           typename ClauseSet::iterator it)
+{
+    typename ClauseSet::value_type chosen = *it;
+    unprocessed.erase(it);
+    return chosen;
+}
+
+// Selection policies pick a clause without removing it, select also removes
+// and returns it
+
+// selection policy: always take the first clause
+struct select_first
+{
+    template <class ClauseSet>
+    typename ClauseSet::iterator pick(ClauseSet& unprocessed)
+    {
+        return unprocessed.begin();
+    }
+    template <class ClauseSet>
+    typename ClauseSet::value_type select(ClauseSet& unprocessed)
+    {
+        return take_clause(unprocessed, pick(unprocessed));
+    }
+};
+
+// selection policy: take a random clause
+struct select_random
+{
+    template <class ClauseSet>
+    typename ClauseSet::iterator pick(ClauseSet& unprocessed)
+    {
+        typename ClauseSet::iterator it = unprocessed.begin();
+        advance(it, rand() % unprocessed.size());
+        return it;
+    }
+    template <class ClauseSet>
+    typename ClauseSet::value_type select(ClauseSet& unprocessed)
+    {
+        return take_clause(unprocessed, pick(unprocessed));
+    }
+};
+
+// selection policy: take a random one out of all the shortest clauses
+struct select_shortest
+{
+    template <class ClauseSet>
+    typename ClauseSet::iterator pick(ClauseSet& unprocessed)
+    {
+        typename ClauseSet::iterator it = unprocessed.begin();
+        size_t min_size = (*it).size();
+        int min_cnt = 1;
+        it++;
+        for (; it != unprocessed.end(); it++) {
+            if (min_size > (*it).size()) {
+                min_size = (*it).size();
+                min_cnt = 1;
+            } else if (min_size == (*it).size()) {
+                min_cnt++;
+            }
+        }
+        typename ClauseSet::iterator chosen_it;
+        int which_one = 1 + rand() % min_cnt;
+        for (it = unprocessed.begin();
+             it != unprocessed.end() && which_one > 0; it++) {
+            if (min_size == (*it).size()) {
+                which_one--;
+                if (which_one == 0) {
+                    chosen_it = it;
+                }
+            }
+        }
+        return chosen_it;
+    }
+    template <class ClauseSet>
+    typename ClauseSet::value_type select(ClauseSet& unprocessed)
+    {
+        return take_clause(unprocessed, pick(unprocessed));
+    }
+};
+
+// rejection policy: reject only when there is nothing left to process
+struct reject_never
+{
+    template <class ClauseSet>
+    bool reject(const ClauseSet& unprocessed) const
+    {
+        return unprocessed.empty();
+    }
+    void step(void)
+    {
+    }
+};
+
+// rejection policy: reject after a given number of steps, a step is counted
+// after every selection of a given clause
+struct reject_steps
+{
+    int steps_taken;
+    int steps_limit;
+    reject_steps(int steps = 1) : steps_taken(0), steps_limit(steps)
+    {
+        if (steps <= 0) {
+            throw "Could not create resolution algorithm";
+        }
+    }
+    template <class ClauseSet>
+    bool reject(const ClauseSet& unprocessed) const
+    {
+        return unprocessed.empty() || steps_taken == steps_limit;
+    }
+    void step(void)
+    {
+        steps_taken++;
+    }
+};
+
+// simplification policy: keep every new resolvent
+struct simplify_none
+{
+    template <class Clause, class ClauseSet>
+    bool keep(const Clause&, const ClauseSet&)
+    {
+        return true;
+    }
+    template <class ClauseSet>
+    void trim(ClauseSet&)
+    {
+    }
+};
+
+// simplification policy: forward subsumption, drop resolvents that contain
+// some processed clause
+struct simplify_subsumed
+{
+    template <class Clause, class ClauseSet>
+    bool keep(const Clause& clause, const ClauseSet& processed)
+    {
+        for (const Clause& proc : processed) {
+            if (subsumes(proc, clause)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    template <class ClauseSet>
+    void trim(ClauseSet&)
+    {
+    }
+};
+
+// Estimated memory taken by a clause stored in a clause set, a tree node per
+// literal and one for the clause itself
+inline size_t clause_bytes(const clause_t& clause)
+{
+    return 96 + 48 * clause.size();
+}
+
+// Fingerprint of a clause, remembered in place of a discarded clause
+inline uint64_t clause_fingerprint(const clause_t& clause)
+{
+    uint64_t hash = clause.size();
+    for (const literal_t& lit : clause) {
+        uint64_t code = 2 * uint64_t(std::get<0>(lit)) + !std::get<1>(lit);
+        hash ^= code + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+// estimated memory taken by a remembered fingerprint, a hash table node and
+// its share of the buckets
+const size_t fingerprint_bytes = 40;
+
+// simplification policy: limited resource strategy on top of another policy.
+// The unprocessed clauses are kept within a clause count and memory budget,
+// and only as many as there are steps left can ever be selected. Clauses
+// heavier than the lightest ones fitting both limits are evicted, and the
+// weight of the heaviest clause kept becomes a cutoff for new resolvents, so
+// they are rejected before being stored. The cutoff is recomputed before
+// every step and lifted once everything fits again. The weight of a clause
+// is its number of literals. A zero budget or step count means no such
+// limit.
+//
+// Discarding is permanent: the fingerprints of discarded clauses are
+// remembered, so a clause derived again after its eviction is rejected
+// without being stored or counted again. The fingerprints count against the
+// memory budget, only a memory budget bounds them. Like any discarded clause,
+// a clause sharing the fingerprint of one may cost a refutation, never its
+// soundness.
+template <class Simplify = simplify_none>
+struct simplify_limited
+{
+    Simplify inner;
+    size_t clause_budget;
+    size_t byte_budget;
+    long steps_left;
+    size_t cutoff;
+    // number of distinct clauses discarded
+    long discarded;
+    std::unordered_set<uint64_t> discarded_prints;
+    simplify_limited(size_t clauses, size_t bytes = 0, long steps = 0,
+                     Simplify simp = Simplify()) :
+        inner(simp), clause_budget(clauses), byte_budget(bytes),
+        steps_left(steps), cutoff(size_t(-1)), discarded(0) {}
+    // remember a discarded clause, counting it the first time
+    template <class Clause>
+    void discard(const Clause& clause)
+    {
+        if (discarded_prints.insert(clause_fingerprint(clause)).second) {
+            discarded++;
+        }
+    }
+    template <class Clause, class ClauseSet>
+    bool keep(const Clause& clause, const ClauseSet& processed)
+    {
+        if (!discarded_prints.empty() &&
+            discarded_prints.count(clause_fingerprint(clause))) {
+            return false;
+        }
+        if (clause.size() > cutoff) {
+            discard(clause);
+            return false;
+        }
+        return inner.keep(clause, processed);
+    }
+    // evict the clauses that do not fit and recompute the cutoff, called
+    // once before every step. The lightest clause is always kept, so a
+    // nonempty set of clauses stays nonempty.
+    template <class ClauseSet>
+    void trim(ClauseSet& unprocessed)
+    {
+        size_t count_limit = clause_budget ? clause_budget : size_t(-1);
+        if (steps_left > 0) {
+            count_limit = std::min(count_limit, size_t(steps_left--));
+        }
+        size_t byte_limit = byte_budget ? byte_budget : size_t(-1);
+        if (byte_budget) {
+            size_t print_bytes = fingerprint_bytes * discarded_prints.size();
+            byte_limit = byte_budget > print_bytes
+                         ? byte_budget - print_bytes : 0;
+        }
+        cutoff = size_t(-1);
+        if (unprocessed.size() <= count_limit && !byte_budget) {
+            return;
+        }
+        // clause counts and sizes by weight
+        std::vector<size_t> counts, bytes;
+        for (const typename ClauseSet::value_type& clause : unprocessed) {
+            if (clause.size() >= counts.size()) {
+                counts.resize(clause.size() + 1, 0);
+                bytes.resize(clause.size() + 1, 0);
+            }
+            counts[clause.size()]++;
+            bytes[clause.size()] += clause_bytes(clause);
+        }
+        // lightest weights fit completely, the first one that does not is
+        // kept only in part; with room for everything there is no cutoff
+        size_t weight = 0, kept_cnt = 0, kept_bytes = 0;
+        for (; weight < counts.size(); weight++) {
+            if (kept_cnt + counts[weight] > count_limit ||
+                kept_bytes + bytes[weight] > byte_limit) {
+                break;
+            }
+            kept_cnt += counts[weight];
+            kept_bytes += bytes[weight];
+        }
+        if (weight == counts.size()) {
+            return;
+        }
+        bool kept_weight = false;
+        typename ClauseSet::iterator it = unprocessed.begin();
+        while (it != unprocessed.end()) {
+            bool keep_it = it->size() < weight;
+            if (it->size() == weight) {
+                // the empty clause and the first clause are always kept
+                keep_it = weight == 0 || kept_cnt == 0 ||
+                          (kept_cnt + 1 <= count_limit &&
+                           kept_bytes + clause_bytes(*it) <= byte_limit);
+                if (keep_it) {
+                    kept_weight = true;
+                    kept_cnt++;
+                    kept_bytes += clause_bytes(*it);
+                }
+            }
+            if (keep_it) {
+                it++;
+            } else {
+                discard(*it);
+                it = unprocessed.erase(it);
+            }
+        }
+        // the cutoff is the heaviest weight kept
+        cutoff = kept_weight || weight == 0 ? weight : weight - 1;
+    }
+};
+
+// given clause algorithm with statically bound heuristics
+template <class Select, class Reject, class Simplify = simplify_none,
+          class ClauseSet = clause_set_t>
+class given_clause_engine
+{
+    private:
+        typedef typename ClauseSet::value_type clause_type;
+        // sets of processes and unprocessed clauses
+        ClauseSet processed;
+        ClauseSet unprocessed;
+        // heuristics
+        Select selection;
+        Reject rejection;
+        Simplify simplification;
+        no_trace trace;
+    public:
+        // constructor, takes initial set of unprocessed clauses and the
+        // policy instances
+        given_clause_engine(ClauseSet& clauses, Select sel = Select(),
+                            Reject rej = Reject(), Simplify simp = Simplify())
+            : unprocessed(clauses), selection(sel), rejection(rej),
+              simplification(simp) {}
+        // main proof method, same loop as resolution_algorithm::prove
+        bool prove(void)
+        {
+            bool proved = false;
+            clause_type chosen_clause;
+            while (!unprocessed.empty() && !proved &&
+                   !rejection.reject(unprocessed)) {
+                simplification.trim(unprocessed);
+                chosen_clause = selection.select(unprocessed);
+                rejection.step();
+                if (chosen_clause.empty()) {
+                    proved = true;
+                } else {
+                    processed.insert(chosen_clause);
+                    generate_resolvents(chosen_clause, processed, unprocessed,
+                                        simplification, trace);
+                }
+            }
+            return proved;
+        }
+        // accessors of the pointers to the clause sets
+        ClauseSet* get_processed(void) { return &processed; }
+        ClauseSet* get_unprocessed(void) { return &unprocessed; }
+        Simplify& get_simplification(void) { return simplification; }
+};
+
+#endif
@@ -1,8 +1,18 @@
 // neural_net.h
 // Header file for a feedforward neural network with one hidden layer
 
+#ifndef NEURAL_NET_H
+#define NEURAL_NET_H
+
+#include <random>
 #include <vector>
 
+// random double value from the given interval, based on rand()
+double gen_rand(double, double);
+// random double value from the given interval, drawn from an engine, or from
+// rand() if it is 0
+double gen_rand(std::mt19937*, double, double);
+
 // completely connected feedforward neural network with one hidden layer
 class neural_net
 {
@@ -30,9 +40,12 @@ class neural_net
         std::vector<double> current_outputs;
         std::vector<double> current_output_est;
         std::vector<double> hidden_values;
+        // inference copies read the weights directly
+        friend class frozen_net;
     public:
-        // constructor, takes sizes of layers and training parameters
-        neural_net(int, int, int, double, int);
+        // constructor, takes sizes of layers and training parameters, and
+        // optionally the engine drawing the initial weights
+        neural_net(int, int, int, double, int, std::mt19937* rng = 0);
         // compute outputs of the neural network
         std::vector<double>& feed_forward(std::vector<double>&);
         // derivatives of squared errors
@@ -46,3 +59,4 @@ class neural_net
         void print(void);
 };
 
+#endif
@@ -0,0 +1,23 @@
+// parser.h
+// Parser of problems in the SATLIB (DIMACS CNF) format
+
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <istream>
+#include <stdexcept>
+#include "clauses.h"
+
+// error thrown when a stream holds no further problem line, e.g. at the end
+// of a stream of problems
+struct no_problem_error : public std::runtime_error
+{
+    no_problem_error(void) : std::runtime_error("No problem line found") {}
+};
+
+// parse one problem from a stream, optionally reporting the number of
+// variables declared by its "p cnf" line. Throws no_problem_error if there is
+// no problem line, std::runtime_error on any other parsing error
+clause_set_t parse_stream(std::istream&, int* var_cnt = 0);
+
+#endif
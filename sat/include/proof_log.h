@@ -0,0 +1,49 @@
+// proof_log.h
+// Append-only binary log of resolution proofs, checked by proof_check.
+//
+// The log starts with the magic bytes "QLP1", followed by records made of a
+// tag byte and unsigned LEB128 varints. Clauses are numbered from 1 in the
+// order they are logged, literals are coded as 2 * variable + negative.
+//   'i' <literal count> <literal codes...>  input clause
+//   'r' <id - parent a> <id - parent b> <pivot code>
+//                                           resolvent of a and b upon the
+//                                           pivot, which a contains
+//   'e' <clause id>                         the clause is empty, refutation
+
+#ifndef PROOF_LOG_H
+#define PROOF_LOG_H
+
+#include <ostream>
+#include <string>
+#include "clauses.h"
+
+// writer of the log, writes are buffered in memory. The log does not keep the
+// clauses, callers store the number of each logged clause with the clause.
+class proof_log
+{
+    private:
+        std::ostream& out;
+        std::string buffer;
+        // number of the next logged clause
+        unsigned long next_id;
+        // helper methods, append a varint or a literal code to the buffer
+        void put_varint(unsigned long);
+        void put_literal(const literal_t&);
+    public:
+        // constructor, writes the header to the stream
+        proof_log(std::ostream&);
+        // destructor, flushes the buffer
+        ~proof_log(void);
+        // record a clause of the problem, returns its number
+        unsigned long input(const clause_t&);
+        // record a resolvent of the clauses with the given numbers upon a
+        // literal of the first one, returns its number; 0 if a parent was
+        // never logged, then nothing is recorded
+        unsigned long resolvent(unsigned long, unsigned long, const literal_t&);
+        // record that the clause with the given number is empty
+        void refuted(unsigned long);
+        // write out the buffered records
+        void flush(void);
+};
+
+#endif
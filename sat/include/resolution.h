@@ -1,9 +1,25 @@
 // resolution.h
 // Strategy pattern implemented for the main resolution algorithm
 
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
 #include <iostream>
+#include <unordered_map>
+#include "bit_clauses.h"
 #include "clauses.h"
+#include "given_clause.h"
+#include "frozen_net.h"
 #include "neural_net.h"
+#include "proof_log.h"
+
+// refutation complete restrictions of the generation step: none, ordered
+// resolution upon maximal literals only, or set-of-support, where one parent
+// of every resolvent descends from the support clauses
+enum restriction_t { restrict_none, restrict_ordered, restrict_support };
+
+// numbers of clauses in the proof log, by the address of the stored clause
+typedef std::unordered_map<const clause_t*, unsigned long> clause_ids_t;
 
 // generic resolution algorithm structure, abstract class, Strategy pattern
 class resolution_algorithm
@@ -13,8 +29,28 @@ class resolution_algorithm
         // given clause algorithm
         clause_set_t processed;
         clause_set_t unprocessed;
-        // helper method, implements propositional resolution
-        clause_t resolve(clause_t&, clause_t&, literal_t&);
+        // optional log of the proof, not owned, and the numbers of the
+        // processed and unprocessed clauses in it, kept while logging
+        proof_log* proof;
+        clause_ids_t processed_ids;
+        clause_ids_t unprocessed_ids;
+        unsigned long chosen_id;
+        // optional limit of the unprocessed clauses, not owned
+        simplify_limited<>* limit;
+        // restriction of the generation step, its atom order and support
+        restriction_t restriction;
+        order_atoms order;
+        clause_set_t support;
+        bool support_given;
+        // bit copies of the processed clauses used by the generation step
+        processed_bits bits;
+        // number of resolvents stored so far
+        long generated;
+        bool in_support(const clause_t&);
+    protected:
+        // remove the clause chosen by a heuristic from the unprocessed
+        // clauses and return it
+        clause_t take(clause_set_t::iterator);
     public:
         // constructor, takes initial set of unprocessed clauses
         resolution_algorithm(clause_set_t&);
@@ -24,7 +60,7 @@ class resolution_algorithm
         bool prove(void);
         // generating a set of new clauses from the set of processed clauses
         // and a selected given clause, same for every algorithm
-        void generate(clause_t&);
+        void generate(const clause_t&);
         // abstract method for given clause selection
         virtual clause_t choose_clause(void) = 0;
         // abstract method for clause set rejection
@@ -32,11 +68,36 @@ class resolution_algorithm
         // accessors of the pointers to the clause sets
         clause_set_t* get_processed(void) { return &processed; }
         clause_set_t* get_unprocessed(void) { return &unprocessed; }
+        // record the proof found by the next call of prove, 0 disables it
+        void set_proof_log(proof_log* log) { proof = log; }
+        // bound the unprocessed clauses by a limited resource strategy, 0
+        // disables it; the policy counts the discarded clauses
+        void set_resource_limit(simplify_limited<>* lim) { limit = lim; }
+        // select the restriction used by the next call of prove
+        void set_restriction(restriction_t mode) { restriction = mode; }
+        // atom order of ordered resolution, the variable order by default
+        void set_atom_order(const order_atoms& atoms) { order = atoms; }
+        // support clauses of set-of-support resolution, the clauses with a
+        // negative literal by default; the other input clauses must be
+        // satisfiable for the restriction to stay complete
+        void set_support(const clause_set_t&);
+        long get_generated(void) { return generated; }
+        // number of variables, e.g. declared by the "p cnf" line, choosing
+        // the width of the bit clauses used in the generation step; the
+        // largest variable of the input by default, 0 for generic clauses;
+        // set before prove
+        void set_variable_count(int vars) { bits.set_variables(vars); }
 };
 
+// The heuristics below are thin adapters over the policies of the
+// given_clause_engine template, which runs them without virtual dispatch
+
 // heuristic H1: always choose first clause, never reject
 class res_h1 : public resolution_algorithm
 {
+    private:
+        select_first selection;
+        reject_never rejection;
     public:
         res_h1(clause_set_t&);
         virtual clause_t choose_clause(void);
@@ -47,8 +108,8 @@ class res_h1 : public resolution_algorithm
 class res_h2 : public resolution_algorithm
 {
     private:
-        int steps_taken;
-        int steps_limit;
+        select_random selection;
+        reject_steps rejection;
     public:
         res_h2(clause_set_t&, int);
         virtual clause_t choose_clause(void);
@@ -60,8 +121,8 @@ class res_h2 : public resolution_algorithm
 class res_h3 : public resolution_algorithm
 {
     private:
-        int steps_taken;
-        int steps_limit;
+        select_shortest selection;
+        reject_steps rejection;
     public:
         res_h3(clause_set_t&, int);
         virtual clause_t choose_clause(void);
@@ -76,22 +137,44 @@ class res_qlearn : public resolution_algorithm
         int steps_taken;
         int steps_limit;
         bool previously_took;
-        const int state_feature_cnt = 2;
-        const int action_feature_cnt = 1;
-        const int hidden_neurons_cnt = 10;
-        const double nn_learn_rate = 0.001;
-        const double ql_learn_rate = 0.001;
-        const int learn_iter_cnt = 200;
-        const double discount_factor = 0.999;
-        double prob_take = 0.2;
+        static constexpr int state_feature_cnt = 2;
+        static constexpr int action_feature_cnt = 1;
+        static constexpr double nn_learn_rate = 0.001;
+        static constexpr double ql_learn_rate = 0.001;
+        static constexpr int learn_iter_cnt = 200;
+        static constexpr double discount_factor = 0.999;
+        double prob_take;
         double lambda;
         double reward;
-        static std::vector<std::vector<double>> in_batch;
-        static std::vector<double> out_batch;
-        static neural_net qfun_est;
+        // engine of the random choices, rand() if 0, not owned
+        std::mt19937* rng;
+        // training samples collected during the proof attempt
+        std::vector<std::vector<double> > in_batch;
+        std::vector<std::vector<double> > out_batch;
+        // Q-function estimate, owned by the caller, and its inference copy
+        // used for scoring clauses
+        neural_net& qfun_est;
+        frozen_net qfun_fast;
+        inference_t inference;
     public:
-        res_qlearn(clause_set_t&, int, double, double);
+        // hidden layer size of a new Q-function estimate by default
+        static constexpr int hidden_neurons_cnt = 10;
+        // takes the clauses, the Q-function estimate, the step limit, the
+        // Boltzmann base, the reward for a proof, the probability of taking
+        // a step as a training sample and the engine of the random choices
+        res_qlearn(clause_set_t&, neural_net&, int, double, double,
+                   double prob = 0.2, std::mt19937* random = 0);
+        // untrained Q-function estimate with the given hidden layer size,
+        // its weights drawn from the engine if given
+        static neural_net new_qfun(int hidden_cnt = hidden_neurons_cnt,
+                                   std::mt19937* random = 0);
         virtual clause_t choose_clause(void);
         virtual bool should_reject(void);
+        // train the Q-function estimate on the collected samples
+        void learn(void);
+        // precision of clause scoring, single precision by default
+        void set_inference(inference_t);
+        int get_steps_taken(void) { return steps_taken; }
 };
 
+#endif
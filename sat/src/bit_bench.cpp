@@ -0,0 +1,77 @@
+// bit_bench.cpp
+// Compares the generation step on generic std::set clauses with the one on
+// bit clauses, on generated instances small enough for the bit
+// representation. Both runs use the same heuristic on the same seed, and as
+// the bit kernels store the same resolvents as generic clauses, both follow
+// the same search; the runs column confirms it.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "bit_clauses.h"
+#include "generator.h"
+#include "resolution.h"
+
+typedef std::chrono::duration<double, std::milli> millis_t;
+
+// run H3 with the given variable count, 0 for generic clauses, and add its
+// time to the total
+bool run_h3(clause_set_t& cs, int steps, int vars, unsigned int seed,
+            millis_t& total, long& generated)
+{
+    srand(seed);
+    res_h3 algo(cs, steps);
+    algo.set_variable_count(vars);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    bool proved = algo.prove();
+    total += std::chrono::steady_clock::now() - start;
+    generated = algo.get_generated();
+    return proved;
+}
+
+// run H3 with both representations and print their times
+void compare(const std::string& family, int size, clause_set_t& cs, int steps,
+             int repeats)
+{
+    int vars = max_variable(cs);
+    millis_t set_time(0), bit_time(0);
+    int proved = 0;
+    bool same = true;
+    for (int r = 0; r < repeats; r++) {
+        long set_generated = 0, bit_generated = 0;
+        bool set_proved = run_h3(cs, steps, 0, r, set_time, set_generated);
+        bool bit_proved = run_h3(cs, steps, vars, r, bit_time, bit_generated);
+        same &= set_proved == bit_proved && set_generated == bit_generated;
+        proved += set_proved;
+    }
+    std::cout << family << "\t" << size << "\t" << vars << "\t"
+              << proved << "/" << repeats << "\t"
+              << (same ? "same" : "differ") << "\t"
+              << set_time.count() / repeats << "\t"
+              << bit_time.count() / repeats << "\t"
+              << set_time.count() / bit_time.count() << std::endl;
+}
+
+// optional arguments: step limit and number of repeats
+int main(int argc, char** argv)
+{
+    int steps = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+    std::cout << "family\tsize\tvars\tunsat\truns\tset_ms\tbit_ms\tspeedup"
+              << std::endl;
+    for (int n = 20; n <= 100; n += 40) {
+        clause_set_t cs = gen_random_ksat(n, 3, 4.26, n);
+        compare("ksat", n, cs, steps, repeats);
+    }
+    for (int n = 2; n <= 6; n++) {
+        clause_set_t cs = gen_pigeonhole(n);
+        compare("php", n, cs, steps, repeats);
+    }
+    for (int n = 4; n <= 40; n += 12) {
+        clause_set_t cs = gen_parity_chain(n, true, n);
+        compare("parity", n, cs, steps, repeats);
+    }
+    return 0;
+}
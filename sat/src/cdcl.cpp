@@ -0,0 +1,444 @@
+// cdcl.cpp
+// Implementation of the conflict-driven clause learning solver.
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "cdcl.h"
+
+// decay factors of variable and clause activities
+const double var_decay = 0.95;
+const double clause_decay = 0.999;
+// conflicts in the first restart, later ones follow the Luby sequence
+const int restart_base = 100;
+
+// A helper function computing the x-th element of the Luby sequence with
+// base y, 1 1 2 1 1 2 4 1 1 2 ... for y = 2
+double luby(double y, int x)
+{
+    int size = 1;
+    int seq = 0;
+    while (size < x + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    while (size - 1 != x) {
+        size = (size - 1) >> 1;
+        seq--;
+        x = x % size;
+    }
+    return pow(y, seq);
+}
+
+// Constructor, unit clauses are assigned at level 0, tautologies dropped
+cdcl_solver::cdcl_solver(const clause_set_t& problem, int vars) :
+    var_cnt(vars), trivially_unsat(false), var_inc(1.0), clause_inc(1.0),
+    prop_head(0), conflicts(0), decisions(0), propagations(0), learnt_cnt(0)
+{
+    for (const clause_t& cl : problem) {
+        if (!cl.empty() && static_cast<int> (std::get<0>(*cl.rbegin())) > var_cnt) {
+            var_cnt = std::get<0>(*cl.rbegin());
+        }
+    }
+    watches.resize(2 * var_cnt + 2);
+    value.assign(var_cnt + 1, -1);
+    level.assign(var_cnt + 1, 0);
+    reason.assign(var_cnt + 1, -1);
+    phase.assign(var_cnt + 1, false);
+    activity.assign(var_cnt + 1, 0.0);
+    heap_pos.assign(var_cnt + 1, -1);
+    seen.assign(var_cnt + 1, 0);
+    for (int v = 1; v <= var_cnt; v++) {
+        heap_insert(v);
+    }
+    std::vector<int> units;
+    for (const clause_t& cl : problem) {
+        std::vector<int> lits;
+        bool tautology = false;
+        for (const literal_t& lit : cl) {
+            int code = 2 * std::get<0>(lit) + !std::get<1>(lit);
+            // complementary literals are neighbours in a clause
+            tautology |= !lits.empty() && lits.back() == (code ^ 1);
+            lits.push_back(code);
+        }
+        if (tautology) {
+            continue;
+        } else if (lits.empty()) {
+            trivially_unsat = true;
+        } else if (lits.size() == 1) {
+            units.push_back(lits[0]);
+        } else {
+            add_clause(lits, false);
+        }
+    }
+    for (int lit : units) {
+        if (lit_value(lit) == 0) {
+            trivially_unsat = true;
+        } else if (lit_value(lit) < 0) {
+            assign(lit, -1);
+        }
+    }
+}
+
+// Value of a literal, 1 true, 0 false, -1 unassigned
+int cdcl_solver::lit_value(int lit) const
+{
+    int v = value[lit >> 1];
+    return v < 0 ? -1 : v ^ (lit & 1);
+}
+
+// Make a literal true at the current decision level
+void cdcl_solver::assign(int lit, int why)
+{
+    int v = lit >> 1;
+    value[v] = !(lit & 1);
+    level[v] = trail_lim.size();
+    reason[v] = why;
+    trail.push_back(lit);
+}
+
+// Add a clause, its first two literals are watched. Learned clauses have the
+// asserting literal first and a literal of the highest remaining level second.
+void cdcl_solver::add_clause(std::vector<int>& lits, bool learnt)
+{
+    clause_rec rec;
+    rec.lits = lits;
+    rec.learnt = learnt;
+    rec.deleted = false;
+    rec.activity = 0.0;
+    clauses.push_back(rec);
+    int idx = clauses.size() - 1;
+    watches[lits[0] ^ 1].push_back(idx);
+    watches[lits[1] ^ 1].push_back(idx);
+    if (learnt) {
+        learnt_cnt++;
+        bump_clause(idx);
+    }
+}
+
+// Unit propagation with two watched literals, returns the conflicting clause
+// or -1. Watches of deleted clauses are dropped on the way.
+int cdcl_solver::propagate(void)
+{
+    int confl = -1;
+    while (prop_head < trail.size() && confl < 0) {
+        int p = trail[prop_head++];
+        int false_lit = p ^ 1;
+        std::vector<int>& ws = watches[p];
+        size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            int ci = ws[i++];
+            clause_rec& c = clauses[ci];
+            if (c.deleted) {
+                continue;
+            }
+            if (c.lits[0] == false_lit) {
+                std::swap(c.lits[0], c.lits[1]);
+            }
+            if (lit_value(c.lits[0]) == 1) {
+                ws[j++] = ci;
+                continue;
+            }
+            // look for a new literal to watch
+            bool moved = false;
+            for (size_t k = 2; k < c.lits.size(); k++) {
+                if (lit_value(c.lits[k]) != 0) {
+                    std::swap(c.lits[1], c.lits[k]);
+                    watches[c.lits[1] ^ 1].push_back(ci);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+            ws[j++] = ci;
+            if (lit_value(c.lits[0]) == 0) {
+                confl = ci;
+                while (i < ws.size()) {
+                    ws[j++] = ws[i++];
+                }
+            } else {
+                assign(c.lits[0], ci);
+                propagations++;
+            }
+        }
+        ws.resize(j);
+    }
+    return confl;
+}
+
+// First UIP conflict analysis, produces the learned clause with the
+// asserting literal first and the level to backtrack to
+void cdcl_solver::analyze(int confl, std::vector<int>& learnt, int& bt_level)
+{
+    int path_cnt = 0;
+    int p = -1;
+    int index = trail.size() - 1;
+    int curr_level = trail_lim.size();
+    learnt.assign(1, -1);
+    do {
+        clause_rec& c = clauses[confl];
+        if (c.learnt) {
+            bump_clause(confl);
+        }
+        // the literal implied by a reason clause is its first one
+        for (size_t j = (p == -1 ? 0 : 1); j < c.lits.size(); j++) {
+            int q = c.lits[j];
+            int v = q >> 1;
+            if (!seen[v] && level[v] > 0) {
+                bump_var(v);
+                seen[v] = 1;
+                if (level[v] >= curr_level) {
+                    path_cnt++;
+                } else {
+                    learnt.push_back(q);
+                }
+            }
+        }
+        while (!seen[trail[index] >> 1]) {
+            index--;
+        }
+        p = trail[index--];
+        confl = reason[p >> 1];
+        seen[p >> 1] = 0;
+        path_cnt--;
+    } while (path_cnt > 0);
+    learnt[0] = p ^ 1;
+    bt_level = 0;
+    for (size_t j = 1; j < learnt.size(); j++) {
+        seen[learnt[j] >> 1] = 0;
+        if (level[learnt[j] >> 1] > bt_level) {
+            bt_level = level[learnt[j] >> 1];
+            std::swap(learnt[1], learnt[j]);
+        }
+    }
+}
+
+// Undo all assignments above the given decision level, their values are
+// kept as the preferred phases
+void cdcl_solver::backtrack(int lvl)
+{
+    if (static_cast<int> (trail_lim.size()) <= lvl) {
+        return;
+    }
+    for (int i = trail.size() - 1; i >= trail_lim[lvl]; i--) {
+        int v = trail[i] >> 1;
+        phase[v] = value[v];
+        value[v] = -1;
+        reason[v] = -1;
+        heap_insert(v);
+    }
+    trail.resize(trail_lim[lvl]);
+    trail_lim.resize(lvl);
+    prop_head = trail.size();
+}
+
+// VSIDS bump of a variable involved in a conflict
+void cdcl_solver::bump_var(int v)
+{
+    activity[v] += var_inc;
+    if (activity[v] > 1e100) {
+        for (int u = 1; u <= var_cnt; u++) {
+            activity[u] *= 1e-100;
+        }
+        var_inc *= 1e-100;
+    }
+    if (heap_pos[v] >= 0) {
+        heap_up(heap_pos[v]);
+    }
+}
+
+// Bump of a learned clause involved in a conflict
+void cdcl_solver::bump_clause(int ci)
+{
+    clauses[ci].activity += clause_inc;
+    if (clauses[ci].activity > 1e20) {
+        for (clause_rec& c : clauses) {
+            c.activity *= 1e-20;
+        }
+        clause_inc *= 1e-20;
+    }
+}
+
+// Delete the less active half of the learned clauses, except binary clauses
+// and clauses which are reasons of current assignments
+void cdcl_solver::reduce_learnts(void)
+{
+    std::vector<std::pair<double, int> > candidates;
+    for (size_t ci = 0; ci < clauses.size(); ci++) {
+        clause_rec& c = clauses[ci];
+        if (!c.learnt || c.deleted || c.lits.size() <= 2) {
+            continue;
+        }
+        int v = c.lits[0] >> 1;
+        if (reason[v] == static_cast<int> (ci) && lit_value(c.lits[0]) == 1) {
+            continue;
+        }
+        candidates.push_back(std::make_pair(c.activity, ci));
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (size_t i = 0; i < candidates.size() / 2; i++) {
+        clause_rec& c = clauses[candidates[i].second];
+        c.deleted = true;
+        std::vector<int>().swap(c.lits);
+        learnt_cnt--;
+    }
+}
+
+// Most active unassigned variable, 0 if all are assigned
+int cdcl_solver::pick_branch(void)
+{
+    while (!heap.empty()) {
+        int v = heap_pop();
+        if (value[v] < 0) {
+            return v;
+        }
+    }
+    return 0;
+}
+
+// Heap operations, the heap keeps the most active variable on top
+void cdcl_solver::heap_up(int i)
+{
+    int v = heap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (activity[heap[parent]] >= activity[v]) {
+            break;
+        }
+        heap[i] = heap[parent];
+        heap_pos[heap[i]] = i;
+        i = parent;
+    }
+    heap[i] = v;
+    heap_pos[v] = i;
+}
+
+void cdcl_solver::heap_down(int i)
+{
+    int v = heap[i];
+    int size = heap.size();
+    while (2 * i + 1 < size) {
+        int child = 2 * i + 1;
+        if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]]) {
+            child++;
+        }
+        if (activity[heap[child]] <= activity[v]) {
+            break;
+        }
+        heap[i] = heap[child];
+        heap_pos[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = v;
+    heap_pos[v] = i;
+}
+
+void cdcl_solver::heap_insert(int v)
+{
+    if (heap_pos[v] >= 0) {
+        return;
+    }
+    heap.push_back(v);
+    heap_pos[v] = heap.size() - 1;
+    heap_up(heap.size() - 1);
+}
+
+int cdcl_solver::heap_pop(void)
+{
+    int v = heap[0];
+    heap_pos[v] = -1;
+    int last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        heap_pos[last] = 0;
+        heap_down(0);
+    }
+    return v;
+}
+
+// Main search loop
+cdcl_result cdcl_solver::solve(long conflict_limit)
+{
+    if (trivially_unsat || propagate() >= 0) {
+        trivially_unsat = true;
+        return cdcl_unsat;
+    }
+    double max_learnts = std::max(clauses.size() / 3.0, 100.0);
+    std::vector<int> learnt;
+    for (int restart = 0; ; restart++) {
+        long restart_conflicts = 0;
+        long restart_limit = luby(2.0, restart) * restart_base;
+        while (true) {
+            int confl = propagate();
+            if (confl >= 0) {
+                conflicts++;
+                restart_conflicts++;
+                if (trail_lim.empty()) {
+                    trivially_unsat = true;
+                    return cdcl_unsat;
+                }
+                int bt_level = 0;
+                analyze(confl, learnt, bt_level);
+                backtrack(bt_level);
+                if (learnt.size() == 1) {
+                    assign(learnt[0], -1);
+                } else {
+                    add_clause(learnt, true);
+                    assign(learnt[0], clauses.size() - 1);
+                }
+                var_inc /= var_decay;
+                clause_inc /= clause_decay;
+                continue;
+            }
+            if (conflict_limit >= 0 && conflicts >= conflict_limit) {
+                backtrack(0);
+                return cdcl_unknown;
+            }
+            if (restart_conflicts >= restart_limit) {
+                backtrack(0);
+                break;
+            }
+            if (learnt_cnt - static_cast<int> (trail.size()) >= max_learnts) {
+                reduce_learnts();
+                max_learnts *= 1.1;
+            }
+            int v = pick_branch();
+            if (v == 0) {
+                return cdcl_sat;
+            }
+            decisions++;
+            trail_lim.push_back(trail.size());
+            assign(2 * v + !phase[v], -1);
+        }
+    }
+}
+
+// Satisfying assignment found by the last search
+std::vector<bool> cdcl_solver::get_model(void) const
+{
+    std::vector<bool> model(var_cnt + 1, false);
+    for (int v = 1; v <= var_cnt; v++) {
+        model[v] = value[v] == 1;
+    }
+    return model;
+}
+
+// Check an assignment against every clause of a problem
+bool check_model(const clause_set_t& problem, const std::vector<bool>& model)
+{
+    for (const clause_t& cl : problem) {
+        bool satisfied = false;
+        for (const literal_t& lit : cl) {
+            proposition_t v = std::get<0>(lit);
+            satisfied |= v < model.size() && model[v] == std::get<1>(lit);
+        }
+        if (!satisfied) {
+            return false;
+        }
+    }
+    return true;
+}
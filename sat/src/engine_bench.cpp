@@ -0,0 +1,74 @@
+// engine_bench.cpp
+// Compares the virtual heuristic classes with the policy-template given clause
+// engine running the same heuristic on the same generated instances. Both use
+// generic std::set clauses, the bit kernels of res_h3 are switched off, so
+// only the dispatch of the heuristics differs.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "generator.h"
+#include "given_clause.h"
+#include "resolution.h"
+
+typedef std::chrono::duration<double, std::milli> millis_t;
+
+// run both forms of H3 with the same random seed, so they take identical
+// steps, and print their times
+void compare(const std::string& family, int size, clause_set_t& cs, int steps,
+             int repeats)
+{
+    millis_t virt_time(0), templ_time(0);
+    bool virt_proved = false, templ_proved = false;
+    size_t virt_kept = 0, templ_kept = 0;
+    for (int r = 0; r < repeats; r++) {
+        srand(r);
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        res_h3 virt(cs, steps);
+        virt.set_variable_count(0);
+        virt_proved = virt.prove();
+        virt_time += std::chrono::steady_clock::now() - start;
+        virt_kept = (*virt.get_processed()).size()
+                    + (*virt.get_unprocessed()).size();
+
+        srand(r);
+        start = std::chrono::steady_clock::now();
+        given_clause_engine<select_shortest, reject_steps> templ(
+            cs, select_shortest(), reject_steps(steps));
+        templ_proved = templ.prove();
+        templ_time += std::chrono::steady_clock::now() - start;
+        templ_kept = (*templ.get_processed()).size()
+                     + (*templ.get_unprocessed()).size();
+    }
+    std::cout << family << "\t" << size << "\t"
+              << (virt_proved ? "UNSAT" : "UNKNOWN") << "\t"
+              << (virt_proved == templ_proved && virt_kept == templ_kept
+                  ? "same" : "DIFFERENT") << "\t"
+              << virt_time.count() / repeats << "\t"
+              << templ_time.count() / repeats << "\t"
+              << virt_time.count() / templ_time.count() << std::endl;
+}
+
+// optional arguments: step limit and number of repeats
+int main(int argc, char** argv)
+{
+    int steps = argc > 1 ? std::atoi(argv[1]) : 300;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+    std::cout << "family\tsize\tresult\truns\tvirtual_ms\ttemplate_ms\tspeedup"
+              << std::endl;
+    for (int n = 20; n <= 60; n += 20) {
+        clause_set_t cs = gen_random_ksat(n, 3, 4.26, n);
+        compare("ksat", n, cs, steps, repeats);
+    }
+    for (int n = 2; n <= 5; n++) {
+        clause_set_t cs = gen_pigeonhole(n);
+        compare("php", n, cs, steps, repeats);
+    }
+    for (int n = 4; n <= 12; n += 4) {
+        clause_set_t cs = gen_parity_chain(n, true, n);
+        compare("parity", n, cs, steps, repeats);
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+// frozen_net.cpp
+// Implementation of the inference-only network exported from a trained
+// neural_net
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "frozen_net.h"
+
+// Rational approximation of the sigmoid, 0.5 + 0.5 * tanh(x / 2) with tanh
+// given by its continued fraction expansion cut after the seventh order and
+// saturated outside [-4.97, 4.97]. Monotone, absolute error below 1e-4 and no
+// call to exp.
+inline float fast_sigmoid(float x)
+{
+    float y = std::min(std::max(0.5f * x, -4.97f), 4.97f);
+    float y2 = y * y;
+    float p = y * (135135.0f + y2 * (17325.0f + y2 * (378.0f + y2)));
+    float q = 135135.0f + y2 * (62370.0f + y2 * (3150.0f + y2 * 28.0f));
+    return 0.5f + 0.5f * p / q;
+}
+
+// A helper function quantizing one row of weights to 8 bits, symmetric
+// around zero, returns the scale of the row
+float quantize_row(const std::vector<double>& row, int8_t* out)
+{
+    double max_abs = 0.0;
+    for (double w : row) {
+        max_abs = std::max(max_abs, std::fabs(w));
+    }
+    double scale = max_abs > 0.0 ? max_abs / 127.0 : 1.0;
+    for (size_t j = 0; j < row.size(); j++) {
+        out[j] = static_cast<int8_t> (std::lround(row[j] / scale));
+    }
+    return static_cast<float> (scale);
+}
+
+// Empty network
+frozen_net::frozen_net(void) :
+    input_cnt(0), hidden_cnt(0), output_cnt(0), quantized(false)
+{
+}
+
+// Copy of a trained network in single precision, or with 8-bit weights
+frozen_net::frozen_net(const neural_net& net, bool quantize) :
+    input_cnt(net.input_neurons_length),
+    hidden_cnt(net.hidden_neurons_length),
+    output_cnt(net.output_neurons_length),
+    quantized(quantize),
+    hidden_scale(net.hidden_neurons_length, 1.0f),
+    output_scale(net.output_neurons_length, 1.0f),
+    hidden_bias(net.hidden_neuron_bias.begin(), net.hidden_neuron_bias.end()),
+    output_bias(net.output_neuron_bias.begin(), net.output_neuron_bias.end()),
+    hidden_base(net.hidden_neurons_length, 0.0f),
+    hidden_values(net.hidden_neurons_length, 0.0f),
+    outputs(net.output_neurons_length, 0.0f)
+{
+    if (quantized) {
+        hidden_weights_q.resize(hidden_cnt * input_cnt);
+        output_weights_q.resize(output_cnt * hidden_cnt);
+        for (int i = 0; i < hidden_cnt; i++) {
+            hidden_scale[i] = quantize_row(net.hidden_neuron_weights[i],
+                                           &hidden_weights_q[i * input_cnt]);
+        }
+        for (int i = 0; i < output_cnt; i++) {
+            output_scale[i] = quantize_row(net.output_neuron_weights[i],
+                                           &output_weights_q[i * hidden_cnt]);
+        }
+    } else {
+        for (int i = 0; i < hidden_cnt; i++) {
+            hidden_weights.insert(hidden_weights.end(),
+                                  net.hidden_neuron_weights[i].begin(),
+                                  net.hidden_neuron_weights[i].end());
+        }
+        for (int i = 0; i < output_cnt; i++) {
+            output_weights.insert(output_weights.end(),
+                                  net.output_neuron_weights[i].begin(),
+                                  net.output_neuron_weights[i].end());
+        }
+    }
+}
+
+// Weighted sum of the inputs from..to of a hidden neuron, 8-bit weights are
+// widened to float
+float frozen_net::hidden_sum(int neuron, int from, int to, const float* in)
+{
+    float sum = 0.0f;
+    if (quantized) {
+        const int8_t* w = &hidden_weights_q[neuron * input_cnt];
+        for (int j = from; j < to; j++) {
+            sum += w[j] * in[j - from];
+        }
+        return sum * hidden_scale[neuron];
+    }
+    const float* w = &hidden_weights[neuron * input_cnt];
+    for (int j = from; j < to; j++) {
+        sum += w[j] * in[j - from];
+    }
+    return sum;
+}
+
+// Activate the hidden pre-activations and compute the first output
+float frozen_net::first_output(void)
+{
+    float sum = 0.0f;
+    for (int j = 0; j < hidden_cnt; j++) {
+        hidden_values[j] = fast_sigmoid(hidden_values[j]);
+    }
+    if (quantized) {
+        for (int j = 0; j < hidden_cnt; j++) {
+            sum += output_weights_q[j] * hidden_values[j];
+        }
+        return output_bias[0] + sum * output_scale[0];
+    }
+    for (int j = 0; j < hidden_cnt; j++) {
+        sum += output_weights[j] * hidden_values[j];
+    }
+    return output_bias[0] + sum;
+}
+
+// Compute the outputs for one input vector
+const std::vector<float>& frozen_net::feed_forward(const float* inputs)
+{
+    for (int i = 0; i < hidden_cnt; i++) {
+        hidden_values[i] = hidden_bias[i]
+                           + hidden_sum(i, 0, input_cnt, inputs);
+    }
+    outputs[0] = first_output();
+    for (int i = 1; i < output_cnt; i++) {
+        float sum = 0.0f;
+        for (int j = 0; j < hidden_cnt; j++) {
+            sum += (quantized ? output_weights_q[i * hidden_cnt + j]
+                              : output_weights[i * hidden_cnt + j])
+                   * hidden_values[j];
+        }
+        outputs[i] = output_bias[i] + sum * output_scale[i];
+    }
+    return outputs;
+}
+
+// Score many actions in the same state. The part of the hidden layer
+// depending on the state is computed once, then every action only adds its
+// own inputs.
+void frozen_net::score_actions(const float* state, int state_cnt,
+                               const float* actions, int count, float* scores)
+{
+    int action_cnt = input_cnt - state_cnt;
+    for (int i = 0; i < hidden_cnt; i++) {
+        hidden_base[i] = hidden_bias[i] + hidden_sum(i, 0, state_cnt, state);
+    }
+    for (int a = 0; a < count; a++) {
+        const float* action = actions + a * action_cnt;
+        for (int i = 0; i < hidden_cnt; i++) {
+            hidden_values[i] = hidden_base[i]
+                               + hidden_sum(i, state_cnt, input_cnt, action);
+        }
+        scores[a] = first_output();
+    }
+}
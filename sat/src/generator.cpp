@@ -0,0 +1,180 @@
+// generator.cpp
+// Implementation of seeded benchmark instance generators. All of them build
+// clause sets directly, so no file has to be read to obtain a problem.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include "generator.h"
+
+// A helper function producing a clause over k distinct random variables with
+// random polarities
+clause_t gen_random_clause(std::mt19937& rng, int vars, int k)
+{
+    std::uniform_int_distribution<int> var_dist(1, vars);
+    std::bernoulli_distribution sign_dist(0.5);
+    clause_t cl;
+    std::set<proposition_t> used;
+    while (static_cast<int> (used.size()) < k) {
+        proposition_t var = var_dist(rng);
+        if (used.insert(var).second) {
+            cl.insert(literal_t(var, sign_dist(rng)));
+        }
+    }
+    return cl;
+}
+
+// A helper function counting the distinct clauses over k distinct variables
+// out of vars with polarities allowed by sign_cnt of the 2^k patterns
+double distinct_clauses(int vars, int k, double sign_cnt)
+{
+    double cnt = sign_cnt;
+    for (int i = 0; i < k; i++) {
+        cnt = cnt * (vars - i) / (i + 1);
+    }
+    return cnt;
+}
+
+// Uniform random k-SAT at a given clause to variable ratio
+clause_set_t gen_random_ksat(int vars, int k, double ratio, unsigned int seed)
+{
+    if (k <= 0 || k > vars || ratio <= 0.0) {
+        throw "Could not generate random k-SAT instance";
+    }
+    std::mt19937 rng(seed);
+    int clause_cnt = static_cast<int> (std::lround(ratio * vars));
+    if (clause_cnt > distinct_clauses(vars, k, std::pow(2.0, k))) {
+        throw "Could not generate random k-SAT instance";
+    }
+    // duplicates are drawn again, so the ratio is exact
+    clause_set_t cls;
+    while (static_cast<int> (cls.size()) < clause_cnt) {
+        cls.insert(gen_random_clause(rng, vars, k));
+    }
+    return cls;
+}
+
+// Pigeonhole principle, holes + 1 pigeons cannot sit in holes holes. Variable
+// p * holes + h + 1 states that pigeon p sits in hole h.
+clause_set_t gen_pigeonhole(int holes)
+{
+    if (holes <= 0) {
+        throw "Could not generate pigeonhole instance";
+    }
+    clause_set_t cls;
+    // every pigeon sits in some hole
+    for (int p = 0; p <= holes; p++) {
+        clause_t cl;
+        for (int h = 0; h < holes; h++) {
+            cl.insert(literal_t(p * holes + h + 1, true));
+        }
+        cls.insert(cl);
+    }
+    // no two pigeons share a hole
+    for (int h = 0; h < holes; h++) {
+        for (int p = 0; p <= holes; p++) {
+            for (int q = p + 1; q <= holes; q++) {
+                clause_t cl;
+                cl.insert(literal_t(p * holes + h + 1, false));
+                cl.insert(literal_t(q * holes + h + 1, false));
+                cls.insert(cl);
+            }
+        }
+    }
+    return cls;
+}
+
+// A helper function adding the four clauses of out = a xor b
+void add_xor(clause_set_t& cls, proposition_t a, proposition_t b,
+             proposition_t out)
+{
+    for (int i = 0; i < 4; i++) {
+        bool sa = i & 1;
+        bool sb = i & 2;
+        // forbid the assignment a = !sa, b = !sb, out = !(!sa xor !sb)
+        clause_t cl;
+        cl.insert(literal_t(a, sa));
+        cl.insert(literal_t(b, sb));
+        cl.insert(literal_t(out, sa != sb));
+        cls.insert(cl);
+    }
+}
+
+// A helper function encoding the chain over the given variable order, using
+// fresh auxiliary variables starting at next_var, and asserting its parity
+void add_parity_chain(clause_set_t& cls, std::vector<proposition_t>& order,
+                      proposition_t& next_var, bool parity)
+{
+    proposition_t acc = order[0];
+    for (size_t i = 1; i < order.size(); i++) {
+        proposition_t out = next_var++;
+        add_xor(cls, acc, order[i], out);
+        acc = out;
+    }
+    clause_t unit;
+    unit.insert(literal_t(acc, parity));
+    cls.insert(unit);
+}
+
+// Parity chain over vars variables with a random target parity
+clause_set_t gen_parity_chain(int vars, bool unsat, unsigned int seed)
+{
+    if (vars <= 0) {
+        throw "Could not generate parity chain instance";
+    }
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution sign_dist(0.5);
+    bool parity = sign_dist(rng);
+    std::vector<proposition_t> order(vars);
+    for (int i = 0; i < vars; i++) {
+        order[i] = i + 1;
+    }
+    clause_set_t cls;
+    proposition_t next_var = vars + 1;
+    add_parity_chain(cls, order, next_var, parity);
+    if (unsat) {
+        std::shuffle(order.begin(), order.end(), rng);
+        add_parity_chain(cls, order, next_var, !parity);
+    }
+    return cls;
+}
+
+// Random k-SAT with a planted solution, clauses falsified by the hidden
+// assignment and duplicates are drawn again
+clause_set_t gen_planted_ksat(int vars, int k, double ratio, unsigned int seed,
+                              std::vector<bool>* model)
+{
+    if (k <= 0 || k > vars || ratio <= 0.0) {
+        throw "Could not generate planted k-SAT instance";
+    }
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution sign_dist(0.5);
+    std::vector<bool> planted(vars + 1, false);
+    for (int i = 1; i <= vars; i++) {
+        planted[i] = sign_dist(rng);
+    }
+    int clause_cnt = static_cast<int> (std::lround(ratio * vars));
+    if (clause_cnt > distinct_clauses(vars, k, std::pow(2.0, k) - 1)) {
+        throw "Could not generate planted k-SAT instance";
+    }
+    // duplicates are drawn again, so the ratio is exact
+    clause_set_t cls;
+    while (static_cast<int> (cls.size()) < clause_cnt) {
+        clause_t cl;
+        bool satisfied = false;
+        while (!satisfied) {
+            cl = gen_random_clause(rng, vars, k);
+            for (literal_t lit : cl) {
+                satisfied |= planted[std::get<0>(lit)] == std::get<1>(lit);
+            }
+        }
+        cls.insert(cl);
+    }
+    if (model) {
+        *model = planted;
+    }
+    return cls;
+}
@@ -0,0 +1,144 @@
+// main.cpp
+// Driver solving the SATLIB problems in files named on the standard input.
+//
+// usage: test [qlearn|cdcl|both] < file_list
+//
+// qlearn trains the Q-learning resolution heuristic on every problem, cdcl
+// decides every problem by clause learning search and both tries the search
+// first, training the heuristic only on problems it did not show satisfiable.
+
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "cdcl.h"
+#include "neural_net.h"
+#include "parser.h"
+#include "resolution.h"
+
+#ifndef DEBUG
+#define DEBUG 0
+#endif
+
+#define debug_write(obj) \
+    if (DEBUG) { \
+        std::cout << obj; }
+
+double l = 1.0;
+
+// algorithms run by the driver
+enum solve_mode { mode_qlearn, mode_cdcl, mode_both };
+
+// parse a problem, false on a parsing error
+bool read_problem(std::istream& in, clause_set_t& cs, int& var_cnt)
+{
+    try {
+        cs = parse_stream(in, &var_cnt);
+    } catch (const std::exception& ex) {
+        debug_write("Parsing error detected!" << std::endl);
+        debug_write(ex.what() << std::endl);
+        debug_write("Finishing..." << std::endl);
+        return false;
+    }
+    return true;
+}
+
+// decide a concrete problem by clause learning search, input from a stream,
+// returns the outcome
+cdcl_result search_problem(std::istream& in)
+{
+    clause_set_t cs;
+    int var_cnt = 0;
+    if (!read_problem(in, cs, var_cnt)) {
+        return cdcl_unknown;
+    }
+    cdcl_solver solver(cs, var_cnt);
+    cdcl_result result = solver.solve();
+    if (result == cdcl_sat && !check_model(cs, solver.get_model())) {
+        // a wrong model is never reported as SAT
+        std::cerr << "CDCL model does not satisfy the problem" << std::endl;
+        return cdcl_unknown;
+    }
+    debug_write((result == cdcl_sat ? "SAT" :
+                 result == cdcl_unsat ? "UNSAT" : "UNKNOWN")
+                << " conflicts " << solver.get_conflicts()
+                << " decisions " << solver.get_decisions()
+                << " propagations " << solver.get_propagations()
+                << std::endl);
+    if (result == cdcl_sat) {
+        std::vector<bool> model = solver.get_model();
+        debug_write("v");
+        for (int v = 1; v <= var_cnt; v++) {
+            debug_write(" " << (model[v] ? v : -v));
+        }
+        debug_write(" 0" << std::endl);
+    }
+    return result;
+}
+
+// parse and solve a concrete problem, input from
+// a stream, the Q-function estimate is trained afterwards
+bool solve_problem(std::istream& in, neural_net& qfun)
+{
+    clause_set_t cs;
+    int var_cnt = 0;
+    if (!read_problem(in, cs, var_cnt)) {
+        return false;
+    }
+    res_qlearn algo(cs, qfun, 100, l, 1000.0);
+    //res_h3 algo(cs, 100);
+    algo.set_variable_count(var_cnt);
+    bool proved = algo.prove();
+    algo.learn();
+    debug_write((proved ? "SUCCESS" : "FAIL") << std::endl);
+    return proved;
+}
+
+// accept a list of file names from an input stream, then
+// solve all problems in the given files
+void process_files(std::istream& in, solve_mode mode)
+{
+    std::string file_name;
+    neural_net qfun = res_qlearn::new_qfun();
+    while (std::getline(in, file_name)) {
+        std::fstream fs;
+        debug_write("*******************************" << std::endl);
+        debug_write(file_name << std::endl);
+        debug_write("*******************************" << std::endl);
+        fs.open(file_name, std::fstream::in);
+        int runs = mode == mode_cdcl ? 0 : 5000;
+        if (mode != mode_qlearn && search_problem(fs) == cdcl_sat) {
+            // resolution only refutes, there is nothing left to train on
+            runs = 0;
+        }
+        for (int i = 0; i < runs; i++, l += 0.0001) {
+            // every run starts from the beginning of the file
+            fs.clear();
+            fs.seekg(0);
+            solve_problem(fs, qfun);
+        }
+        fs.close();
+    }
+}
+
+// get the mode from the command line and file names from stdin
+int main(int argc, char** argv)
+{
+    solve_mode mode = mode_qlearn;
+    if (argc > 1) {
+        std::string name(argv[1]);
+        if (name == "cdcl") {
+            mode = mode_cdcl;
+        } else if (name == "both") {
+            mode = mode_both;
+        } else if (name != "qlearn") {
+            std::cerr << "usage: " << argv[0] << " [qlearn|cdcl|both]"
+                      << " < file_list" << std::endl;
+            return 1;
+        }
+    }
+    process_files(std::cin, mode);
+    return 0;
+}
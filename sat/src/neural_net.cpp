@@ -24,15 +24,26 @@ double gen_rand(double low, double high)
     return low + r * (high - low);
 }
 
+// A helper function for generating a random double value from an engine,
+// which keeps concurrent users of random values apart
+double gen_rand(std::mt19937* rng, double low, double high)
+{
+    if (!rng) {
+        return gen_rand(low, high);
+    }
+    return std::uniform_real_distribution<double>(low, high)(*rng);
+}
+
 double sigmoid(double x)
 {
     return 1.0 / (1.0 + exp(-x));
 }
 
 // Constructor for a neural network, taking layer sizes, learning rate and
-// the number of steps in gradient descent
+// the number of steps in gradient descent, the initial weights are drawn from
+// the engine if given
 neural_net::neural_net(int input_size, int hidden_size, int output_size,
-                       double learn_coeff, int desc_steps) :
+                       double learn_coeff, int desc_steps, std::mt19937* rng) :
     input_neurons_length(input_size),
     hidden_neurons_length(hidden_size),
     output_neurons_length(output_size),
@@ -52,15 +63,15 @@ neural_net::neural_net(int input_size, int hidden_size, int output_size,
     current_output_est(output_size, 0.0)
 {
     for (int i = 0; i < hidden_size; i++) {
-        hidden_neuron_bias[i] = gen_rand(0.0, 1.0);
+        hidden_neuron_bias[i] = gen_rand(rng, 0.0, 1.0);
         for (int j = 0; j < input_size; j++) {
-            hidden_neuron_weights[i][j] = gen_rand(0.0, 1.0);
+            hidden_neuron_weights[i][j] = gen_rand(rng, 0.0, 1.0);
         }
     }
     for (int i = 0; i < output_size; i++) {
-        output_neuron_bias[i] = gen_rand(0.0, 1.0);
+        output_neuron_bias[i] = gen_rand(rng, 0.0, 1.0);
         for (int j = 0; j < hidden_size; j++) {
-            output_neuron_weights[i][j] = gen_rand(0.0, 1.0);
+            output_neuron_weights[i][j] = gen_rand(rng, 0.0, 1.0);
         }
     }
 }
@@ -212,6 +223,8 @@ void neural_net::print(void)
     }
 }
 
+#ifdef NEURAL_NET_DEMO
+// fit the product of two numbers, prints the fit on a grid
 int main(void)
 {
     srand(time(0));
@@ -243,4 +256,4 @@ int main(void)
     }
     return 0;
 }
-
+#endif
@@ -7,9 +7,10 @@
 #include <fstream>
 #include <iostream>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <utility>
-#include "resolution.h"
+#include "parser.h"
 
 #ifndef DEBUG
 #define DEBUG 0
@@ -20,19 +21,35 @@
         std::cout << obj; }
 
 // returns a set of clauses from a stream,
-// expects SATLIB format
-clause_set_t parse_stream(std::istream& in)
+// expects SATLIB format, the declared number of variables is stored in
+// var_cnt if given. Everything before the problem line is skipped, so
+// problems may follow each other in one stream
+clause_set_t parse_stream(std::istream& in, int* var_cnt)
 {
     std::string line;
     clause_set_t cls;
     do {
-        std::getline(in, line);
+        if (!std::getline(in, line)) {
+            throw no_problem_error();
+        }
         // debug_write(line << "\n");
-    } while (line[0] == 'c');
-    line = line.substr(line.find(" ") + 1);
-    line = line.substr(line.find(" ") + 1);
-    line = line.substr(line.find(" ") + 1);
-    int clause_cnt = std::stoi(line);
+    } while (line.empty() || line[0] != 'p');
+    std::string problem_line = line;
+    int declared_vars = 0, clause_cnt = 0;
+    try {
+        line = line.substr(line.find(" ") + 1);
+        line = line.substr(line.find(" ") + 1);
+        declared_vars = std::stoi(line);
+        line = line.substr(line.find(" ") + 1);
+        clause_cnt = std::stoi(line);
+    } catch (const std::logic_error&) {
+        // std::stoi reports no digits or an overflow by its name only
+        throw std::runtime_error("Malformed problem line: " + problem_line);
+    }
+    debug_write("Number of variables: " << declared_vars << "\n");
+    if (var_cnt) {
+        *var_cnt = declared_vars;
+    }
     debug_write("Number of clauses: " << clause_cnt << "\n");
     for (int i = 0; i < clause_cnt; i++) {
         clause_t cl;
@@ -44,57 +61,12 @@ clause_set_t parse_stream(std::istream& in)
             } else if (lit < 0) {
                 cl.insert(literal_t(-lit, false));
             }
-        } while (lit != 0);
+        } while (lit != 0 && in);
+        if (!in) {
+            throw std::runtime_error("Unexpected end of clauses");
+        }
         cls.insert(cl);
     }
     debug_write("Processed clause set" << std::endl);
     return cls;
 }
-
-double l = 1.0;
-
-// parse and solve a concrete problem, input from
-// a stream
-bool solve_problem(std::istream& in)
-{
-    clause_set_t cs;
-    try {
-        cs = parse_stream(in); 
-    } catch (const std::exception& ex) {
-        debug_write("Parsing error detected!" << std::endl);
-        debug_write(ex.what() << std::endl);
-        debug_write("Finishing..." << std::endl);
-        return false;
-    }
-    res_qlearn algo(cs, 100, l, 1000.0);
-    //res_h3 algo(cs, 100);
-    bool proved = algo.prove();
-    debug_write((proved ? "SUCCESS" : "FAIL") << std::endl);
-    return proved;
-}
-
-// accept a list of file names from an input stream, then
-// solve all problems in the given files
-void process_files(std::istream& in)
-{
-    std::string file_name;
-    while (std::getline(in, file_name)) {
-        std::fstream fs;
-        debug_write("*******************************" << std::endl);
-        debug_write(file_name << std::endl);
-        debug_write("*******************************" << std::endl);
-        fs.open(file_name, std::fstream::in);
-        for (int i = 0; i < 5000; i++, l += 0.0001) {
-            solve_problem(fs);
-        }
-        fs.close();
-    }
-}
-
-// get file names from stdin
-int main(int argc, char** argv)
-{
-    process_files(std::cin);
-    return 0;
-}
-
@@ -0,0 +1,188 @@
+// proof_check.cpp
+// Standalone checker of binary proof logs written by proof_log. Every
+// resolvent is recomputed from its parents in a single pass over the log,
+// optionally the input clauses are compared with the original problem.
+//
+// usage: proof_check proof_file [problem_file]
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "parser.h"
+
+// clause as a sorted vector of literal codes, 2 * variable + negative
+typedef std::vector<unsigned long> coded_clause_t;
+
+// reader of the log records
+class log_reader
+{
+    private:
+        const std::string& data;
+        size_t pos;
+    public:
+        log_reader(const std::string& log, size_t start)
+            : data(log), pos(start) {}
+        bool at_end(void) { return pos >= data.size(); }
+        char get_tag(void) { return data[pos++]; }
+        // read an unsigned LEB128 varint
+        bool get_varint(unsigned long& value)
+        {
+            value = 0;
+            for (int shift = 0; pos < data.size() && shift < 64; shift += 7) {
+                unsigned char byte = data[pos++];
+                value |= static_cast<unsigned long> (byte & 0x7f) << shift;
+                if (!(byte & 0x80)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+};
+
+// Resolution of two coded clauses upon a pivot code contained in the first
+// one. Returns an error message, empty if the step is valid.
+std::string resolve_coded(const coded_clause_t& clause_a,
+                          const coded_clause_t& clause_b, unsigned long pivot,
+                          coded_clause_t& new_clause)
+{
+    unsigned long opp_pivot = pivot ^ 1;
+    if (!std::binary_search(clause_a.begin(), clause_a.end(), pivot) ||
+        !std::binary_search(clause_b.begin(), clause_b.end(), opp_pivot)) {
+        return "pivot not contained in parents";
+    }
+    // the pivot is only removed from the first parent, its complement only
+    // from the second one, a parent may contain both
+    coded_clause_t rest_a, rest_b;
+    std::remove_copy(clause_a.begin(), clause_a.end(),
+                     std::back_inserter(rest_a), pivot);
+    std::remove_copy(clause_b.begin(), clause_b.end(),
+                     std::back_inserter(rest_b), opp_pivot);
+    new_clause.clear();
+    std::merge(rest_a.begin(), rest_a.end(), rest_b.begin(), rest_b.end(),
+               std::back_inserter(new_clause));
+    new_clause.erase(std::unique(new_clause.begin(), new_clause.end()),
+                     new_clause.end());
+    // complementary literals are neighbours in the sorted clause
+    for (size_t i = 1; i < new_clause.size(); i++) {
+        if ((new_clause[i] ^ 1) == new_clause[i - 1]) {
+            return "resolvent is a tautology";
+        }
+    }
+    return "";
+}
+
+// conversion of a parsed clause to its coded form
+coded_clause_t code_clause(const clause_t& clause)
+{
+    coded_clause_t coded;
+    for (const literal_t& lit : clause) {
+        coded.push_back(2 * static_cast<unsigned long> (std::get<0>(lit))
+                        + !std::get<1>(lit));
+    }
+    std::sort(coded.begin(), coded.end());
+    return coded;
+}
+
+// Check the whole log, returns an error message, empty if the log is a valid
+// refutation of the problem
+std::string check_log(const std::string& log, std::set<coded_clause_t>* problem)
+{
+    if (log.compare(0, 4, "QLP1") != 0) {
+        return "not a proof log";
+    }
+    std::vector<coded_clause_t> clauses;
+    log_reader reader(log, 4);
+    while (!reader.at_end()) {
+        char tag = reader.get_tag();
+        unsigned long id = clauses.size() + 1;
+        if (tag == 'i') {
+            unsigned long cnt = 0, code = 0;
+            if (!reader.get_varint(cnt)) {
+                return "truncated input clause";
+            }
+            coded_clause_t clause;
+            for (unsigned long i = 0; i < cnt; i++) {
+                if (!reader.get_varint(code)) {
+                    return "truncated input clause";
+                }
+                clause.push_back(code);
+            }
+            std::sort(clause.begin(), clause.end());
+            if (problem && problem->find(clause) == problem->end()) {
+                return "input clause " + std::to_string(id)
+                       + " is not part of the problem";
+            }
+            clauses.push_back(clause);
+        } else if (tag == 'r') {
+            unsigned long dist_a = 0, dist_b = 0, pivot = 0;
+            if (!reader.get_varint(dist_a) || !reader.get_varint(dist_b) ||
+                !reader.get_varint(pivot)) {
+                return "truncated resolvent";
+            }
+            if (dist_a == 0 || dist_a >= id || dist_b == 0 || dist_b >= id) {
+                return "resolvent " + std::to_string(id)
+                       + " refers to unknown parents";
+            }
+            coded_clause_t clause;
+            std::string error = resolve_coded(clauses[id - dist_a - 1],
+                                              clauses[id - dist_b - 1], pivot,
+                                              clause);
+            if (!error.empty()) {
+                return "resolvent " + std::to_string(id) + ": " + error;
+            }
+            clauses.push_back(clause);
+        } else if (tag == 'e') {
+            unsigned long empty_id = 0;
+            if (!reader.get_varint(empty_id) || empty_id == 0 ||
+                empty_id > clauses.size()) {
+                return "refutation refers to an unknown clause";
+            }
+            if (!clauses[empty_id - 1].empty()) {
+                return "clause " + std::to_string(empty_id) + " is not empty";
+            }
+            return "";
+        } else {
+            return "unknown record";
+        }
+    }
+    return "no refutation in the log";
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " proof_file [problem_file]"
+                  << std::endl;
+        return 2;
+    }
+    std::ifstream proof_file(argv[1], std::ios::binary);
+    if (!proof_file) {
+        std::cerr << "Could not open " << argv[1] << std::endl;
+        return 2;
+    }
+    std::ostringstream contents;
+    contents << proof_file.rdbuf();
+    std::set<coded_clause_t> problem;
+    if (argc > 2) {
+        std::ifstream problem_file(argv[2]);
+        try {
+            for (const clause_t& clause : parse_stream(problem_file)) {
+                problem.insert(code_clause(clause));
+            }
+        } catch (const std::exception& ex) {
+            std::cerr << argv[2] << ": " << ex.what() << std::endl;
+            return 2;
+        }
+    }
+    std::string error = check_log(contents.str(), argc > 2 ? &problem : 0);
+    if (!error.empty()) {
+        std::cout << "INVALID: " << error << std::endl;
+        return 1;
+    }
+    std::cout << "VERIFIED" << std::endl;
+    return 0;
+}
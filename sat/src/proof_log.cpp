@@ -0,0 +1,88 @@
+// proof_log.cpp
+// Implementation of the binary proof log writer.
+
+#include <ostream>
+#include <string>
+#include "proof_log.h"
+
+// size of the buffer which triggers a write to the stream
+const size_t flush_size = 1 << 16;
+
+// Constructor, the log is empty apart from its header
+proof_log::proof_log(std::ostream& stream) : out(stream), next_id(1)
+{
+    buffer.reserve(flush_size + 64);
+    buffer.append("QLP1");
+}
+
+// Destructor, nothing may be left in the buffer
+proof_log::~proof_log(void)
+{
+    flush();
+}
+
+// Append an unsigned LEB128 varint, seven bits per byte, lowest first
+void proof_log::put_varint(unsigned long value)
+{
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char> ((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char> (value));
+}
+
+// Append the code of a literal
+void proof_log::put_literal(const literal_t& lit)
+{
+    put_varint(2 * static_cast<unsigned long> (std::get<0>(lit))
+               + !std::get<1>(lit));
+}
+
+// Record a clause of the problem
+unsigned long proof_log::input(const clause_t& clause)
+{
+    buffer.push_back('i');
+    put_varint(clause.size());
+    for (const literal_t& lit : clause) {
+        put_literal(lit);
+    }
+    if (buffer.size() >= flush_size) {
+        flush();
+    }
+    return next_id++;
+}
+
+// Record a resolvent given the numbers of its parents and the literal of the
+// first parent it was resolved upon. Parents are referred to by the distance
+// of their numbers, which keeps the varints short.
+unsigned long proof_log::resolvent(unsigned long id_a, unsigned long id_b,
+                                   const literal_t& lit_res)
+{
+    if (id_a == 0 || id_b == 0) {
+        return 0;
+    }
+    buffer.push_back('r');
+    put_varint(next_id - id_a);
+    put_varint(next_id - id_b);
+    put_literal(lit_res);
+    if (buffer.size() >= flush_size) {
+        flush();
+    }
+    return next_id++;
+}
+
+// Record the end of the refutation
+void proof_log::refuted(unsigned long id)
+{
+    buffer.push_back('e');
+    put_varint(id);
+    flush();
+}
+
+// Write out the buffered records
+void proof_log::flush(void)
+{
+    out.write(buffer.data(), buffer.size());
+    out.flush();
+    buffer.clear();
+}
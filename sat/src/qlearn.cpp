@@ -1,8 +1,11 @@
-// resolution.cpp
-// Implementation of the given clause algorithm and the most important helper
-// methods. Also present are implementations of basic heuristics.
+// qlearn.cpp
+// Implementation of the Q-learning heuristic, which estimates the value of
+// choosing a clause with a neural network and samples clauses from the
+// corresponding Boltzmann distribution.
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -19,45 +22,37 @@
     if (DEBUG) { \
         std::cout << obj; }
 
-// A debugging method for pretty-printing a clause
-void print_clause(clause_t clause)
-{
-    if (DEBUG) {
-        debug_write("{ ");
-        for (literal_t lit : clause) {
-            if (!std::get<1>(lit)) {
-                debug_write("-");
-            }
-            debug_write(std::get<0>(lit));
-            debug_write(" ");
-        }
-        debug_write("} ");
-    }
-}
-
-// generate random number
-double gen_rand(double low, double high)
-{
-    double r = static_cast <float> (rand()) / static_cast <float> (RAND_MAX);
-    return low + r * (high - low);
-}
-
-qfun_est(state_feature_cnt + action_feature_cnt, hidden_neurons_cnt, 1,
-         learn_rate, learn_iter_cnt);
-
 // Q-learning constructor
-// adds nothing
-res_qlearn::res_qlearn(clause_set_t& clauses, int steps, double lambda_choose,
-                       double reward_proof)
-    : resolution_algorithm(clauses)
+// takes the Q-function estimate, which is shared by consecutive proof
+// attempts and trained by learn()
+res_qlearn::res_qlearn(clause_set_t& clauses, neural_net& qfun, int steps,
+                       double lambda_choose, double reward_proof, double prob,
+                       std::mt19937* random)
+    : resolution_algorithm(clauses), rng(random), qfun_est(qfun),
+      qfun_fast(qfun, false), inference(infer_float)
 {
     debug_write("qlearn used\n");
+    if (steps <= 0) {
+        throw "Could not create resolution algorithm";
+    }
     steps_limit = steps;
+    steps_taken = 0;
     lambda = lambda_choose;
     reward = reward_proof;
+    prob_take = prob;
     previously_took = false;
 }
 
+// A new, untrained Q-function estimate of the shape res_qlearn expects
+neural_net res_qlearn::new_qfun(int hidden_cnt, std::mt19937* random)
+{
+    if (hidden_cnt <= 0) {
+        throw "Could not create Q-function estimate";
+    }
+    return neural_net(state_feature_cnt + action_feature_cnt, hidden_cnt, 1,
+                      nn_learn_rate, learn_iter_cnt, random);
+}
+
 // qlearn method of choosing the clause
 clause_t res_qlearn::choose_clause(void)
 {
@@ -65,7 +60,6 @@ clause_t res_qlearn::choose_clause(void)
     double qfun_max = 0.0;
     clause_set_t::iterator pr_it = (*get_processed()).begin();
     clause_set_t::iterator unpr_it = (*get_unprocessed()).begin();
-    clause_t::iterator clause_it;
     std::vector<double> inputs(state_feature_cnt + action_feature_cnt, 0.0);
     std::vector<double> p_result((*get_unprocessed()).size(), 0.0);
     // TODO: unprocessed set features
@@ -77,55 +71,79 @@ clause_t res_qlearn::choose_clause(void)
         avg_length += (*pr_it).size();
         unit_prop += ((*pr_it).size() == 1);
     }
-    avg_length /= (*get_processed()).size();
+    if (!(*get_processed()).empty()) {
+        avg_length /= (*get_processed()).size();
+        unit_prop /= (*get_processed()).size();
+    }
     inputs[0] = avg_length;
-    unit_prop /= (*get_processed()).size();
     inputs[1] = unit_prop;
-    for (int i = 0; unpr_it != (*get_unprocessed()).end(); unpr_it++, i++) {
-        // TODO: clause features
-        // clause length
-        inputs[state_feature_cnt + 0] = (*unpr_it).size();
-/*        // ...?
-        inputs[state_feature_cnt + 1] = 0.0;
-        // ...?
-        inputs[state_feature_cnt + 2] = 0.0;*/
-        // distribution
-        double qfun_res = qfun_est.feed_forward(inputs)[0];
-        if (qfun_max < qfun_res) {
-            qfun_max = qfun_res;
+    std::vector<double> qfun_res((*get_unprocessed()).size(), 0.0);
+    // clause length scored best by the inference copy
+    float best_length = 0.0f;
+    if (inference == infer_double) {
+        for (int i = 0; unpr_it != (*get_unprocessed()).end(); unpr_it++, i++) {
+            // TODO: clause features
+            // clause length
+            inputs[state_feature_cnt + 0] = (*unpr_it).size();
+            qfun_res[i] = qfun_est.feed_forward(inputs)[0];
+        }
+    } else {
+        // all clauses are scored at once by the inference copy
+        float state[state_feature_cnt] = {static_cast<float> (avg_length),
+                                          static_cast<float> (unit_prop)};
+        std::vector<float> actions(qfun_res.size() * action_feature_cnt);
+        std::vector<float> scores(qfun_res.size());
+        for (int i = 0; unpr_it != (*get_unprocessed()).end(); unpr_it++, i++) {
+            actions[i * action_feature_cnt + 0] = (*unpr_it).size();
         }
-        p_result[i] = pow(lambda, qfun_res);
+        qfun_fast.score_actions(state, state_feature_cnt, actions.data(),
+                                scores.size(), scores.data());
+        qfun_res.assign(scores.begin(), scores.end());
+        best_length = actions[(std::max_element(scores.begin(), scores.end())
+                               - scores.begin()) * action_feature_cnt];
+    }
+    // distribution
+    for (size_t i = 0; i < qfun_res.size(); i++) {
+        if (qfun_max < qfun_res[i]) {
+            qfun_max = qfun_res[i];
+        }
+        p_result[i] = pow(lambda, qfun_res[i]);
         p_total += p_result[i];
     }
     if (previously_took) {
-        out_batch.back() += ql_learn_rate * discount_factor * qfun_max;
+        // training targets stay in double precision, the inference copy only
+        // ranks the clauses, so the best ranked one is evaluated again
+        if (inference != infer_double) {
+            inputs[state_feature_cnt + 0] = best_length;
+            qfun_max = qfun_est.feed_forward(inputs)[0];
+        }
+        out_batch.back()[0] += ql_learn_rate * discount_factor * qfun_max;
     }
-    double r = gen_rand(0.0, p_total);
+    double r = gen_rand(rng, 0.0, p_total);
     double p_sofar = 0.0;
-    int cl_idx = 0;
-    for (int i = 0; cl_idx < (*get_unprocessed()).end(); cl_idx++, i++) {
+    clause_set_t::iterator chosen_it = (*get_unprocessed()).begin();
+    for (int i = 0; i + 1 < static_cast<int> (p_result.size()); chosen_it++, i++) {
         p_sofar += p_result[i];
         if (p_sofar >= r) {
             break;
         }
     }
+    clause_t chosen = take(chosen_it);
     steps_taken++;
-    // possibly add sample to batch 
-    if (gen_rand(0.0, 1.0) < prob_take) {
+    // possibly add sample to batch
+    if (gen_rand(rng, 0.0, 1.0) < prob_take) {
         previously_took = true;
+        inputs[state_feature_cnt + 0] = chosen.size();
         in_batch.push_back(inputs);
-        if ((*get_unprocessed())[cl_idx].empty()) {
-            out_batch.push_back(
-                (1.0 - ql_learn_rate) * qfun_est.feed_forward(inputs)[0] +
-                ql_learn_rate * reward);
-        } else {
-            out_batch.push_back(
-                (1.0 - ql_learn_rate) * qfun_est.feed_forward(inputs)[0]);
+        double target = (1.0 - ql_learn_rate) * qfun_est.feed_forward(inputs)[0];
+        if (chosen.empty()) {
+            target += ql_learn_rate * reward;
         }
+        out_batch.push_back(std::vector<double>(1, target));
     } else {
         previously_took = false;
     }
-    return (*get_unprocessed())[cl_idx];
+    return chosen;
 }
 
 // qlearn method of rejecting a set of clauses
@@ -135,3 +153,24 @@ bool res_qlearn::should_reject(void)
     return (*get_unprocessed()).empty() || steps_taken == steps_limit;
 }
 
+// Train the Q-function estimate on the samples collected so far, which are
+// discarded afterwards
+void res_qlearn::learn(void)
+{
+    if (!in_batch.empty()) {
+        qfun_est.back_propagate(in_batch, out_batch);
+        in_batch.clear();
+        out_batch.clear();
+        set_inference(inference);
+    }
+}
+
+// Choose the precision of clause scoring, the inference copy of the
+// Q-function estimate is refreshed
+void res_qlearn::set_inference(inference_t precision)
+{
+    inference = precision;
+    if (inference != infer_double) {
+        qfun_fast = frozen_net(qfun_est, false);
+    }
+}
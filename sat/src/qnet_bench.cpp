@@ -0,0 +1,114 @@
+// qnet_bench.cpp
+// Accuracy and speed of the single precision and 8-bit inference copies of a
+// trained Q-function estimate, compared with the double precision network.
+// The 8-bit copy only stores its weights in 8 bits and computes in single
+// precision, so it shows the accuracy lost to storage, not a faster path.
+// Accuracy is the largest error, the share of clause pairs ranked in the
+// same order and the mean loss of value when taking the best scored clause.
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "frozen_net.h"
+#include "neural_net.h"
+#include "resolution.h"
+
+typedef std::chrono::duration<double, std::nano> nanos_t;
+
+// state and action values in the ranges res_qlearn produces
+void random_state(std::vector<double>& state)
+{
+    state[0] = gen_rand(1.0, 10.0);
+    state[1] = gen_rand(0.0, 1.0);
+}
+
+int main(int argc, char** argv)
+{
+    const int state_cnt = 2;
+    const int actions_per_state = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int states = argc > 2 ? std::atoi(argv[2]) : 500;
+    const double tie_tolerance = 1e-3;
+    srand(1);
+
+    // train on a smooth target so the weights are not just random
+    neural_net qfun = res_qlearn::new_qfun();
+    std::vector<std::vector<double> > x(200, std::vector<double>(3, 0.0));
+    std::vector<std::vector<double> > y(200, std::vector<double>(1, 0.0));
+    for (size_t i = 0; i < x.size(); i++) {
+        random_state(x[i]);
+        x[i][2] = gen_rand(0.0, 20.0);
+        y[i][0] = 10.0 - x[i][2] + x[i][0] * x[i][1];
+    }
+    qfun.back_propagate(x, y);
+    frozen_net fast(qfun, false);
+    frozen_net quant(qfun, true);
+
+    std::vector<double> inputs(3, 0.0);
+    std::vector<double> exact(actions_per_state);
+    std::vector<float> state(state_cnt), actions(actions_per_state);
+    std::vector<float> scores_f(actions_per_state), scores_q(actions_per_state);
+    nanos_t time_d(0), time_f(0), time_q(0);
+    double err_f = 0.0, err_q = 0.0;
+    long pairs = 0, agree_f = 0, agree_q = 0;
+    double regret_f = 0.0, regret_q = 0.0;
+    for (int s = 0; s < states; s++) {
+        random_state(inputs);
+        state[0] = inputs[0];
+        state[1] = inputs[1];
+        for (int a = 0; a < actions_per_state; a++) {
+            actions[a] = gen_rand(0.0, 20.0);
+        }
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        for (int a = 0; a < actions_per_state; a++) {
+            inputs[2] = actions[a];
+            exact[a] = qfun.feed_forward(inputs)[0];
+        }
+        time_d += std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        fast.score_actions(state.data(), state_cnt, actions.data(),
+                           actions_per_state, scores_f.data());
+        time_f += std::chrono::steady_clock::now() - start;
+        start = std::chrono::steady_clock::now();
+        quant.score_actions(state.data(), state_cnt, actions.data(),
+                            actions_per_state, scores_q.data());
+        time_q += std::chrono::steady_clock::now() - start;
+
+        int best_d = 0, best_f = 0, best_q = 0;
+        for (int a = 0; a < actions_per_state; a++) {
+            err_f = std::max(err_f, std::fabs(scores_f[a] - exact[a]));
+            err_q = std::max(err_q, std::fabs(scores_q[a] - exact[a]));
+            best_d = exact[a] > exact[best_d] ? a : best_d;
+            best_f = scores_f[a] > scores_f[best_f] ? a : best_f;
+            best_q = scores_q[a] > scores_q[best_q] ? a : best_q;
+            for (int b = 0; b < a; b++) {
+                // the trained network has plateaus, near ties say nothing
+                if (std::fabs(exact[a] - exact[b]) < tie_tolerance) {
+                    continue;
+                }
+                bool order = exact[a] > exact[b];
+                pairs++;
+                agree_f += order == (scores_f[a] > scores_f[b]);
+                agree_q += order == (scores_q[a] > scores_q[b]);
+            }
+        }
+        regret_f += exact[best_d] - exact[best_f];
+        regret_q += exact[best_d] - exact[best_q];
+    }
+    long scored = long(states) * actions_per_state;
+    std::cout << "precision\tns_per_clause\tspeedup\tmax_abs_err"
+              << "\tpair_order\tbest_regret" << std::endl;
+    std::cout << "double\t" << time_d.count() / scored << "\t1\t0\t1\t0"
+              << std::endl;
+    std::cout << "float\t" << time_f.count() / scored << "\t"
+              << time_d.count() / time_f.count() << "\t" << err_f << "\t"
+              << double(agree_f) / pairs << "\t" << regret_f / states
+              << std::endl;
+    std::cout << "int8_weights\t" << time_q.count() / scored << "\t"
+              << time_d.count() / time_q.count() << "\t" << err_q << "\t"
+              << double(agree_q) / pairs << "\t" << regret_q / states
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+// regress.cpp
+// Regression check of the resolution provers on satisfiable problems, which
+// none of them may refute. Every problem named on the command line is given
+// to res_h3 with generic and with bit clauses under every restriction, and
+// to the given clause engine, until saturation or the step limit.
+//
+// usage: regress problem_file...
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "parser.h"
+#include "resolution.h"
+
+// step limit of every attempt
+const int regress_steps = 2000;
+
+// run res_h3 with or without the bit kernels, true if it refuted the problem
+bool refuted_h3(clause_set_t& cs, int var_cnt, restriction_t restriction)
+{
+    srand(1);
+    res_h3 algo(cs, regress_steps);
+    algo.set_variable_count(var_cnt);
+    algo.set_restriction(restriction);
+    return algo.prove();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " problem_file..." << std::endl;
+        return 2;
+    }
+    const char* names[] = {"none", "ordered", "support"};
+    const restriction_t restrictions[] = {restrict_none, restrict_ordered,
+                                          restrict_support};
+    int failures = 0;
+    for (int f = 1; f < argc; f++) {
+        std::ifstream in(argv[f]);
+        clause_set_t cs;
+        int var_cnt = 0;
+        try {
+            cs = parse_stream(in, &var_cnt);
+        } catch (const std::exception& ex) {
+            std::cerr << argv[f] << ": " << ex.what() << std::endl;
+            return 2;
+        }
+        for (int i = 0; i < 3; i++) {
+            if (refuted_h3(cs, 0, restrictions[i])) {
+                std::cout << argv[f] << ": generic " << names[i]
+                          << " refuted a satisfiable problem" << std::endl;
+                failures++;
+            }
+            if (refuted_h3(cs, var_cnt, restrictions[i])) {
+                std::cout << argv[f] << ": bits " << names[i]
+                          << " refuted a satisfiable problem" << std::endl;
+                failures++;
+            }
+        }
+        srand(1);
+        given_clause_engine<select_shortest, reject_steps>
+            engine(cs, select_shortest(), reject_steps(regress_steps));
+        if (engine.prove()) {
+            std::cout << argv[f] << ": engine refuted a satisfiable problem"
+                      << std::endl;
+            failures++;
+        }
+    }
+    if (failures == 0) {
+        std::cout << "PASSED" << std::endl;
+    }
+    return failures ? 1 : 0;
+}
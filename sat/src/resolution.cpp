@@ -38,6 +38,13 @@ void print_clause(clause_t clause)
 resolution_algorithm::resolution_algorithm(clause_set_t& clauses)
 {
     unprocessed = clauses;
+    proof = 0;
+    chosen_id = 0;
+    limit = 0;
+    restriction = restrict_none;
+    support_given = false;
+    generated = 0;
+    bits.set_variables(max_variable(clauses));
     debug_write("Created the algorithm instance\n");
 }
 
@@ -50,6 +57,28 @@ bool resolution_algorithm::prove(void)
 {
     bool proved = false;
     clause_t chosen_clause;
+    if (proof) {
+        for (const clause_t& cl : unprocessed) {
+            unprocessed_ids[&cl] = proof->input(cl);
+        }
+    }
+    if (restriction == restrict_support) {
+        // clauses outside the support are never given, only resolved with
+        clause_set_t::iterator it = unprocessed.begin();
+        while (it != unprocessed.end()) {
+            if (it->empty() || in_support(*it)) {
+                it++;
+            } else {
+                const clause_t& moved = *processed.insert(*it).first;
+                bits.add(moved);
+                if (proof) {
+                    processed_ids[&moved] = unprocessed_ids[&*it];
+                    unprocessed_ids.erase(&*it);
+                }
+                it = unprocessed.erase(it);
+            }
+        }
+    }
     // main loop
     while (!unprocessed.empty() && !proved && !should_reject()) {
         // more detailed debug information
@@ -64,15 +93,37 @@ bool resolution_algorithm::prove(void)
                 print_clause(cl);
             }
         }*/
+        if (limit) {
+            size_t unprocessed_cnt = unprocessed.size();
+            limit->trim(unprocessed);
+            if (proof && unprocessed.size() != unprocessed_cnt) {
+                // forget the numbers of the evicted clauses
+                clause_ids_t kept_ids;
+                for (const clause_t& cl : unprocessed) {
+                    kept_ids[&cl] = unprocessed_ids[&cl];
+                }
+                unprocessed_ids.swap(kept_ids);
+            }
+        }
         // choose clause (based on heuristic)
         chosen_clause = choose_clause();
         // did we find a contradiction?
         if (chosen_clause.empty()) {
             proved = true;
+            if (proof) {
+                proof->refuted(chosen_id);
+            }
         } else {
             // perform all possible resolutions
-            processed.insert(chosen_clause);
-            generate(chosen_clause);
+            std::pair<clause_set_t::iterator, bool> inserted =
+                processed.insert(chosen_clause);
+            if (inserted.second) {
+                bits.add(*inserted.first);
+                if (proof) {
+                    processed_ids[&*inserted.first] = chosen_id;
+                }
+            }
+            generate(*inserted.first);
         }
         //debug_write("\n");
     }
@@ -80,62 +131,119 @@ bool resolution_algorithm::prove(void)
     return proved;
 }
 
-// Helper method for the theorem proving algorithm. Given two clause
-// references and a reference to the appropriate literal, it produces the
-// clause inferred with the resolution rule
-clause_t resolution_algorithm::resolve(clause_t& clause_a, clause_t& clause_b,
-                                       literal_t& lit_res)
-{
-    // first clause contains the appropriate literal?
-    assert(clause_a.find(lit_res) != clause_a.end());
-    clause_t new_clause;
-    clause_t empty_clause;
-    // copy literals from the two clauses, while avoiding duplicates
-    // inefficient with current implementation, consider different way of
-    // representing clauses
-    for (literal_t lit : clause_a) {
-        if (lit != lit_res) {
-            literal_t opp_lit(std::get<0>(lit), !(std::get<1>(lit)));
-            if (clause_b.find(opp_lit) != clause_b.end()) {
-                return empty_clause;
-            } else {
-                new_clause.insert(lit);
-            }
-        }
+// Remove the chosen clause from the unprocessed clauses, keeping its number
+// in the proof log
+clause_t resolution_algorithm::take(clause_set_t::iterator it)
+{
+    if (proof) {
+        clause_ids_t::iterator id_it = unprocessed_ids.find(&*it);
+        chosen_id = id_it == unprocessed_ids.end() ? 0 : id_it->second;
+        unprocessed_ids.erase(&*it);
     }
-    for (literal_t lit : clause_b) {
-        if (lit != lit_res) {
-            literal_t opp_lit(std::get<0>(lit), !(std::get<1>(lit)));
-            if (clause_a.find(opp_lit) == clause_a.end()) {
-                new_clause.insert(lit);
-            }
-        }
+    return take_clause(unprocessed, it);
+}
+
+// trace writing resolvents to the proof log, the numbers of the parents are
+// found by the addresses of the processed clauses
+struct proof_trace
+{
+    proof_log* log;
+    clause_ids_t& processed_ids;
+    clause_ids_t& unprocessed_ids;
+    unsigned long id_of(const clause_t& clause)
+    {
+        clause_ids_t::iterator it = processed_ids.find(&clause);
+        return it == processed_ids.end() ? 0 : it->second;
+    }
+    void resolvent(const clause_t& clause_a, const clause_t& clause_b,
+                   const literal_t& lit_res, const clause_t& clause_res)
+    {
+        unprocessed_ids[&clause_res] =
+            log->resolvent(id_of(clause_a), id_of(clause_b), lit_res);
+    }
+};
+
+// A helper function running the generation step with the proof trace, if
+// any, on the bit copies of the processed clauses if present
+template <class Simplify, class Order>
+void generate_traced(const clause_t& clause, const clause_set_t& processed,
+                     processed_bits& bits, clause_set_t& unprocessed,
+                     Simplify& simplification, Order& order,
+                     proof_trace* proof)
+{
+    no_trace trace;
+    if (bits.active() && proof) {
+        bits.generate(clause, processed, unprocessed, simplification, *proof,
+                      order);
+    } else if (bits.active()) {
+        bits.generate(clause, processed, unprocessed, simplification, trace,
+                      order);
+    } else if (proof) {
+        generate_resolvents(clause, processed, unprocessed, simplification,
+                            *proof, order);
+    } else {
+        generate_resolvents(clause, processed, unprocessed, simplification,
+                            trace, order);
+    }
+}
+
+// A helper function running the generation step with the ordering policy of
+// the restriction
+template <class Simplify>
+void generate_restricted(const clause_t& clause, const clause_set_t& processed,
+                         processed_bits& bits, clause_set_t& unprocessed,
+                         Simplify& simplification, restriction_t restriction,
+                         order_atoms& order, proof_trace* proof)
+{
+    if (restriction == restrict_ordered) {
+        generate_traced(clause, processed, bits, unprocessed, simplification,
+                        order, proof);
+    } else {
+        order_none all;
+        generate_traced(clause, processed, bits, unprocessed, simplification,
+                        all, proof);
     }
-    return new_clause;
 }
 
 // Generation step in the given clause algorithm. Given a clause, resolution is
 // performed with every claused in the processed clause set.
-void resolution_algorithm::generate(clause_t& clause)
-{
-    // new clauses getting build
-    clause_t clause_res;
-    // iterate over all literals in clause
-    for (literal_t lit : clause) {
-        literal_t opp_lit(std::get<0>(lit), !(std::get<1>(lit)));
-        // iterate over all processed clauses
-        for (clause_t proc : processed) {
-            // can this resolution be performed?
-            if (proc.find(opp_lit) != proc.end()) {
-                clause_res = resolve(clause, proc, lit);
-                // is this a clause we have not seen before?
-                if (processed.find(clause_res) == processed.end() &&
-                    unprocessed.find(clause_res) == unprocessed.end()) {
-                    unprocessed.insert(clause_res);
-                }
-            }
+void resolution_algorithm::generate(const clause_t& clause)
+{
+    size_t before = unprocessed.size();
+    proof_trace log_trace = {proof, processed_ids, unprocessed_ids};
+    proof_trace* trace = proof ? &log_trace : 0;
+    if (limit) {
+        generate_restricted(clause, processed, bits, unprocessed, *limit,
+                            restriction, order, trace);
+    } else {
+        simplify_none simplification;
+        generate_restricted(clause, processed, bits, unprocessed,
+                            simplification, restriction, order, trace);
+    }
+    generated += unprocessed.size() - before;
+}
+
+// Designate the support clauses of set-of-support resolution
+void resolution_algorithm::set_support(const clause_set_t& clauses)
+{
+    support = clauses;
+    support_given = true;
+}
+
+// Is an input clause in the support? Without designated support clauses,
+// those with a negative literal are, the others are satisfied by making
+// every variable true
+bool resolution_algorithm::in_support(const clause_t& clause)
+{
+    if (support_given) {
+        return support.find(clause) != support.end();
+    }
+    for (const literal_t& lit : clause) {
+        if (!std::get<1>(lit)) {
+            return true;
         }
     }
+    return false;
 }
 
 // H1 constructor
@@ -149,9 +257,8 @@ res_h1::res_h1(clause_set_t& clauses) : resolution_algorithm(clauses)
 // always takes the first one
 clause_t res_h1::choose_clause(void)
 {
-    clause_set_t::iterator it = (*get_unprocessed()).begin();
-    clause_t chosen = *it;
-    (*get_unprocessed()).erase(it);
+    clause_t chosen = take(selection.pick(*get_unprocessed()));
+    rejection.step();
     return chosen;
 }
 
@@ -159,19 +266,14 @@ clause_t res_h1::choose_clause(void)
 // only if set of unprocessed clauses is empty
 bool res_h1::should_reject(void)
 {
-    return (*get_unprocessed()).empty();
+    return rejection.reject(*get_unprocessed());
 }
 
 // H2 constructor
 // maintains number of steps
 res_h2::res_h2(clause_set_t& clauses, int steps) :
-    resolution_algorithm(clauses)
+    resolution_algorithm(clauses), rejection(steps)
 {
-    if (steps <= 0) {
-        throw "Could not create resolution algorithm";
-    }
-    steps_limit = steps;
-    steps_taken = 0;
     debug_write("H2 used\n");
 }
 
@@ -179,11 +281,8 @@ res_h2::res_h2(clause_set_t& clauses, int steps) :
 // pick a random one
 clause_t res_h2::choose_clause(void)
 {
-    clause_set_t::iterator it = (*get_unprocessed()).begin();
-    advance(it, rand() % (*get_unprocessed()).size());
-    clause_t chosen = *it;
-    (*get_unprocessed()).erase(it);
-    steps_taken++;
+    clause_t chosen = take(selection.pick(*get_unprocessed()));
+    rejection.step();
     return chosen;
 }
 
@@ -191,19 +290,14 @@ clause_t res_h2::choose_clause(void)
 // if set of unprocessed clauses is empty or too many steps
 bool res_h2::should_reject(void)
 {
-    return (*get_unprocessed()).empty() || steps_taken == steps_limit;
+    return rejection.reject(*get_unprocessed());
 }
 
 // H3 constructor
 // maintains number of steps
 res_h3::res_h3(clause_set_t& clauses, int steps) :
-    resolution_algorithm(clauses)
+    resolution_algorithm(clauses), rejection(steps)
 {
-    if (steps <= 0) {
-        throw "Could not create resolution algorithm";
-    }
-    steps_limit = steps;
-    steps_taken = 0;
     debug_write("H3 used\n");
 }
 
@@ -211,33 +305,8 @@ res_h3::res_h3(clause_set_t& clauses, int steps) :
 // pick a random one out of all the shortest ones
 clause_t res_h3::choose_clause(void)
 {
-    clause_set_t::iterator it = (*get_unprocessed()).begin();
-    int min_size = (*it).size();
-    int min_cnt = 1;
-    it++;
-    for (; it != (*get_unprocessed()).end(); it++) {
-        if (min_size > (*it).size()) {
-            min_size = (*it).size();
-            min_cnt = 1;
-        } else if (min_size == (*it).size()) {
-            min_cnt++;
-        }
-    }
-    clause_set_t::iterator chosen_it;
-    clause_t chosen;
-    int which_one = 1 + rand() % min_cnt;
-    for (it = (*get_unprocessed()).begin();
-         it != (*get_unprocessed()).end() && which_one > 0; it++) {
-        if (min_size == (*it).size()) {
-            which_one--;
-            if (which_one == 0) {
-                chosen_it = it;
-            }
-        }
-    }
-    chosen = *chosen_it;
-    (*get_unprocessed()).erase(chosen_it);
-    steps_taken++;
+    clause_t chosen = take(selection.pick(*get_unprocessed()));
+    rejection.step();
     return chosen;
 }
 
@@ -245,6 +314,5 @@ clause_t res_h3::choose_clause(void)
 // if set of unprocessed clauses is empty or too many steps
 bool res_h3::should_reject(void)
 {
-    return (*get_unprocessed()).empty() || steps_taken == steps_limit;
+    return rejection.reject(*get_unprocessed());
 }
-
@@ -0,0 +1,86 @@
+// restrict_bench.cpp
+// Comparison of the restrictions of the generation step on unsatisfiable
+// problems, e.g. the uuf and pigeonhole instances of SATLIB, in files named on
+// the standard input. For every restriction the number of stored resolvents
+// and the time to refutation are printed, relative to unrestricted
+// resolution in the last columns. The ratios are only given when both runs
+// refuted the problem, "-" otherwise.
+//
+// usage: restrict_bench [step_limit] < file_list
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "parser.h"
+#include "resolution.h"
+
+// outcome of one proof attempt
+struct attempt
+{
+    bool proved;
+    long generated;
+    double millis;
+};
+
+// run res_h3 with a restriction, seeded the same way for every one
+attempt run_restricted(clause_set_t& cs, int steps, restriction_t restriction)
+{
+    srand(1);
+    res_h3 algo(cs, steps);
+    algo.set_restriction(restriction);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    attempt result;
+    result.proved = algo.prove();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    result.generated = algo.get_generated();
+    result.millis = elapsed.count();
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    int steps = argc > 1 ? std::atoi(argv[1]) : 5000;
+    if (steps <= 0) {
+        std::cerr << "usage: " << argv[0] << " [step_limit] < file_list"
+                  << std::endl;
+        return 1;
+    }
+    const char* names[] = {"none", "ordered", "support"};
+    const restriction_t restrictions[] = {restrict_none, restrict_ordered,
+                                          restrict_support};
+    std::cout << "problem\trestriction\tresult\tresolvents\tms"
+              << "\tresolvent_ratio\tspeedup" << std::endl;
+    std::string file_name;
+    while (std::getline(std::cin, file_name)) {
+        std::fstream fs(file_name, std::fstream::in);
+        clause_set_t cs;
+        try {
+            cs = parse_stream(fs);
+        } catch (const std::exception& ex) {
+            std::cerr << file_name << ": " << ex.what() << std::endl;
+            continue;
+        }
+        attempt base = attempt();
+        for (int i = 0; i < 3; i++) {
+            attempt result = run_restricted(cs, steps, restrictions[i]);
+            if (i == 0) {
+                base = result;
+            }
+            std::cout << file_name << "\t" << names[i] << "\t"
+                      << (result.proved ? "UNSAT" : "UNKNOWN") << "\t"
+                      << result.generated << "\t" << result.millis << "\t";
+            if (base.proved && result.proved && result.generated > 0 &&
+                result.millis > 0) {
+                std::cout << double(base.generated) / result.generated << "\t"
+                          << base.millis / result.millis << std::endl;
+            } else {
+                std::cout << "-\t-" << std::endl;
+            }
+        }
+    }
+    return 0;
+}
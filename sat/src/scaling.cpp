@@ -0,0 +1,68 @@
+// scaling.cpp
+// Load test of the resolution algorithm on generated instances of growing
+// size, without reading any input files. With a clause or memory budget,
+// the unprocessed clauses are bounded by the limited resource strategy, the
+// discarded clauses and the peak resident set size are reported.
+//
+// usage: scaling [max_size] [step_limit] [clause_budget] [byte_budget]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include "generator.h"
+#include "resolution.h"
+
+// run one proof attempt and print a result line
+void run_instance(const std::string& family, int size, clause_set_t& cs,
+                  int steps, size_t budget, size_t bytes)
+{
+    srand(size);
+    res_h3 algo(cs, steps);
+    simplify_limited<> limit(budget, bytes, steps);
+    if (budget || bytes) {
+        algo.set_resource_limit(&limit);
+    }
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    bool proved = algo.prove();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    std::cout << family << "\t" << size << "\t" << cs.size() << "\t"
+              << (proved ? "UNSAT" : "UNKNOWN") << "\t"
+              << (*algo.get_processed()).size() + (*algo.get_unprocessed()).size()
+              << "\t" << limit.discarded << "\t" << usage.ru_maxrss
+              << "\t" << elapsed.count() << std::endl;
+}
+
+// optional arguments: largest size, step limit, clause and byte budget
+int main(int argc, char** argv)
+{
+    int max_size = argc > 1 ? std::atoi(argv[1]) : 50;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 1000;
+    size_t budget = argc > 3 ? std::atol(argv[3]) : 0;
+    size_t bytes = argc > 4 ? std::atol(argv[4]) : 0;
+    unsigned int seed = 1;
+    std::cout << "family\tsize\tclauses\tresult\tkept\tdiscarded\tpeak_kb"
+              << "\tms" << std::endl;
+    for (int n = 10; n <= max_size; n += 10) {
+        clause_set_t cs = gen_random_ksat(n, 3, 4.26, seed);
+        run_instance("ksat", n, cs, steps, budget, bytes);
+    }
+    for (int n = 10; n <= max_size; n += 10) {
+        clause_set_t cs = gen_planted_ksat(n, 3, 4.26, seed);
+        run_instance("planted", n, cs, steps, budget, bytes);
+    }
+    for (int n = 2; n <= max_size / 5; n++) {
+        clause_set_t cs = gen_pigeonhole(n);
+        run_instance("php", n, cs, steps, budget, bytes);
+    }
+    for (int n = 2; n <= max_size / 2; n += 2) {
+        clause_set_t cs = gen_parity_chain(n, true, seed);
+        run_instance("parity", n, cs, steps, budget, bytes);
+    }
+    return 0;
+}
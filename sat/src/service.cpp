@@ -0,0 +1,375 @@
+// service.cpp
+// Long-running solve service. Problems in the SATLIB format are read one
+// after another from the standard input or from connections to a Unix
+// socket, solved by a pool of worker threads with warm Q-function estimates
+// and answered with one result line per problem as soon as it is solved.
+//
+// usage: service [-w workers] [-s socket] [-n steps] [-l lambda]
+//                [-r reward] [-t training_file]... [-e training_rounds]
+//                [-p proof_prefix] [-S seed]
+//
+// result line: <id> <UNSAT|UNKNOWN|ERROR> ms=<time> steps=<steps>
+//              processed=<clauses> unprocessed=<clauses> [proof=<file>]
+//
+// With -p, refutations are logged to <proof_prefix><connection>-<id>.proof
+// and can be checked with proof_check.
+//
+// Every job draws its random choices from its own engine, seeded with the
+// seed, its connection and its id, so results do not depend on which worker
+// takes the job or when.
+
+#include <cerrno>
+#include <csignal>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "neural_net.h"
+#include "parser.h"
+#include "proof_log.h"
+#include "resolution.h"
+
+// input stream buffer reading from a file descriptor
+class fd_streambuf : public std::streambuf
+{
+    private:
+        int fd;
+        char buffer[4096];
+    protected:
+        virtual int_type underflow(void)
+        {
+            ssize_t n;
+            do {
+                n = read(fd, buffer, sizeof(buffer));
+            } while (n < 0 && errno == EINTR);
+            if (n <= 0) {
+                return traits_type::eof();
+            }
+            setg(buffer, buffer, buffer + n);
+            return traits_type::to_int_type(*gptr());
+        }
+    public:
+        fd_streambuf(int in_fd) : fd(in_fd) {}
+};
+
+// client the results are written to, the descriptor is closed when the last
+// job of the client is finished
+class connection
+{
+    private:
+        int fd;
+        bool owns_fd;
+        std::mutex write_lock;
+    public:
+        // number of the connection, used in proof file names
+        long number;
+        connection(int out_fd, bool owns, long num)
+            : fd(out_fd), owns_fd(owns), number(num) {}
+        ~connection(void)
+        {
+            if (owns_fd) {
+                close(fd);
+            }
+        }
+        // write a whole line, lines of different workers are not mixed
+        void write_line(const std::string& line)
+        {
+            std::lock_guard<std::mutex> guard(write_lock);
+            std::string out = line + "\n";
+            size_t done = 0;
+            while (done < out.size()) {
+                ssize_t n = write(fd, out.data() + done, out.size() - done);
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                } else if (n <= 0) {
+                    return;
+                }
+                done += n;
+            }
+        }
+};
+
+// one parsed problem waiting for a worker
+struct job
+{
+    long id;
+    clause_set_t clauses;
+    // variable count declared by the problem
+    int var_cnt;
+    std::shared_ptr<connection> client;
+};
+
+// queue of jobs shared by readers and workers
+class job_queue
+{
+    private:
+        std::deque<job> jobs;
+        std::mutex lock;
+        std::condition_variable ready;
+        bool closed;
+    public:
+        job_queue(void) : closed(false) {}
+        void push(job& j)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            jobs.push_back(std::move(j));
+            ready.notify_one();
+        }
+        // blocks until a job is available, false once the queue is closed
+        // and empty
+        bool pop(job& j)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            ready.wait(guard, [this] { return closed || !jobs.empty(); });
+            if (jobs.empty()) {
+                return false;
+            }
+            j = std::move(jobs.front());
+            jobs.pop_front();
+            return true;
+        }
+        void close(void)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closed = true;
+            ready.notify_all();
+        }
+};
+
+// parameters of the Q-learning heuristic used by the workers
+struct solver_params
+{
+    int steps;
+    double lambda;
+    double reward;
+    double prob_take;
+    // seed of the random engines of the jobs and of the warm up
+    unsigned int seed;
+    // proofs are logged if not empty
+    std::string proof_prefix;
+};
+
+// worker thread, solves jobs with its own copy of the warm Q-function
+void worker(job_queue& queue, const neural_net& warm_qfun,
+            solver_params params)
+{
+    neural_net qfun = warm_qfun;
+    job j;
+    while (queue.pop(j)) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        std::seed_seq seq = {params.seed,
+                             static_cast<unsigned int> (j.client->number),
+                             static_cast<unsigned int> (j.id)};
+        std::mt19937 rng(seq);
+        res_qlearn algo(j.clauses, qfun, params.steps, params.lambda,
+                        params.reward, params.prob_take, &rng);
+        algo.set_variable_count(j.var_cnt);
+        std::string proof_file;
+        std::ofstream proof_stream;
+        std::unique_ptr<proof_log> proof;
+        if (!params.proof_prefix.empty()) {
+            proof_file = params.proof_prefix + std::to_string(j.client->number)
+                         + "-" + std::to_string(j.id) + ".proof";
+            proof_stream.open(proof_file, std::ios::binary);
+            proof.reset(new proof_log(proof_stream));
+            algo.set_proof_log(proof.get());
+        }
+        bool proved = algo.prove();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (proof) {
+            proof.reset();
+            proof_stream.close();
+            if (!proved) {
+                remove(proof_file.c_str());
+            }
+        }
+        std::ostringstream line;
+        line << j.id << " " << (proved ? "UNSAT" : "UNKNOWN")
+             << " ms=" << elapsed.count()
+             << " steps=" << algo.get_steps_taken()
+             << " processed=" << (*algo.get_processed()).size()
+             << " unprocessed=" << (*algo.get_unprocessed()).size();
+        if (proved && !proof_file.empty()) {
+            line << " proof=" << proof_file;
+        }
+        j.client->write_line(line.str());
+        j.client.reset();
+    }
+}
+
+// read problems from a stream until it ends and queue them for the workers.
+// Every problem started by a problem line gets a result line, an error one if
+// it could not be parsed, even when it is cut off by the end of the stream
+void read_problems(std::istream& in, std::shared_ptr<connection> client,
+                   job_queue& queue)
+{
+    for (long id = 1; ; id++) {
+        job j;
+        j.id = id;
+        j.client = client;
+        try {
+            j.clauses = parse_stream(in, &j.var_cnt);
+        } catch (const no_problem_error&) {
+            break;
+        } catch (const std::exception& ex) {
+            std::ostringstream line;
+            line << id << " ERROR " << ex.what();
+            client->write_line(line.str());
+            if (in.eof()) {
+                break;
+            }
+            in.clear();
+            continue;
+        }
+        queue.push(j);
+    }
+}
+
+// serve one socket connection
+void serve_connection(int fd, long number, job_queue& queue)
+{
+    fd_streambuf buf(fd);
+    std::istream in(&buf);
+    read_problems(in, std::make_shared<connection>(fd, true, number), queue);
+}
+
+// accept connections on a Unix socket forever
+int serve_socket(const std::string& path, job_queue& queue)
+{
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (sock < 0 || path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Could not create socket" << std::endl;
+        return 1;
+    }
+    strcpy(addr.sun_path, path.c_str());
+    unlink(path.c_str());
+    if (bind(sock, (struct sockaddr*) &addr, sizeof(addr)) < 0 ||
+        listen(sock, 16) < 0) {
+        std::cerr << "Could not listen on " << path << std::endl;
+        return 1;
+    }
+    for (long number = 1; ; ) {
+        int fd = accept(sock, 0, 0);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Could not accept connection" << std::endl;
+            return 1;
+        }
+        std::thread(serve_connection, fd, number++, std::ref(queue)).detach();
+    }
+}
+
+// train the Q-function estimate on the given files, once per round
+void warm_up(neural_net& qfun, std::vector<std::string>& files, int rounds,
+             solver_params params, std::mt19937& rng)
+{
+    for (int round = 0; round < rounds; round++) {
+        for (std::string& file_name : files) {
+            std::fstream fs(file_name, std::fstream::in);
+            clause_set_t cs;
+            int var_cnt = 0;
+            try {
+                cs = parse_stream(fs, &var_cnt);
+            } catch (const std::exception& ex) {
+                std::cerr << file_name << ": " << ex.what() << std::endl;
+                continue;
+            }
+            res_qlearn algo(cs, qfun, params.steps, params.lambda,
+                            params.reward, params.prob_take, &rng);
+            algo.set_variable_count(var_cnt);
+            algo.prove();
+            algo.learn();
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int workers = std::thread::hardware_concurrency();
+    int rounds = 1;
+    std::string socket_path;
+    std::vector<std::string> training_files;
+    solver_params params;
+    params.steps = 100;
+    params.lambda = 1.0;
+    params.reward = 1000.0;
+    params.prob_take = 0.2;
+    params.seed = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:s:n:l:r:t:e:p:S:")) != -1) {
+        switch (opt) {
+            case 'w': workers = std::atoi(optarg); break;
+            case 's': socket_path = optarg; break;
+            case 'n': params.steps = std::atoi(optarg); break;
+            case 'l': params.lambda = std::atof(optarg); break;
+            case 'r': params.reward = std::atof(optarg); break;
+            case 't': training_files.push_back(optarg); break;
+            case 'e': rounds = std::atoi(optarg); break;
+            case 'p': params.proof_prefix = optarg; break;
+            case 'S': params.seed = std::atoi(optarg); break;
+            default:
+                std::cerr << "usage: " << argv[0] << " [-w workers]"
+                          << " [-s socket] [-n steps] [-l lambda]"
+                          << " [-r reward] [-t training_file]..."
+                          << " [-e training_rounds] [-p proof_prefix]"
+                          << " [-S seed]" << std::endl;
+                return 1;
+        }
+    }
+    if (workers <= 0) {
+        workers = 1;
+    }
+    if (params.steps <= 0) {
+        std::cerr << "Step limit must be positive" << std::endl;
+        return 1;
+    }
+    // a client closing its connection early must not stop the service
+    signal(SIGPIPE, SIG_IGN);
+    // warm up once, every worker starts from the trained estimate
+    std::mt19937 warm_rng(params.seed);
+    neural_net warm_qfun =
+        res_qlearn::new_qfun(res_qlearn::hidden_neurons_cnt, &warm_rng);
+    warm_up(warm_qfun, training_files, rounds, params, warm_rng);
+
+    job_queue queue;
+    std::vector<std::thread> pool;
+    for (int i = 0; i < workers; i++) {
+        pool.push_back(std::thread(worker, std::ref(queue),
+                                   std::cref(warm_qfun), params));
+    }
+    int status = 0;
+    if (socket_path.empty()) {
+        read_problems(std::cin, std::make_shared<connection>(1, false, 0),
+                      queue);
+    } else {
+        status = serve_socket(socket_path, queue);
+    }
+    queue.close();
+    for (std::thread& t : pool) {
+        t.join();
+    }
+    return status;
+}
@@ -0,0 +1,252 @@
+// sweep.cpp
+// Parallel hyperparameter search for the Q-learning heuristic. Every
+// configuration trains its own Q-function estimate on the problems named on
+// the standard input, configurations are spread over worker threads and the
+// proof rate and mean number of steps of each one are tabulated.
+//
+// usage: sweep [-l lambdas] [-r rewards] [-n step_limits] [-p prob_takes]
+//              [-h hidden_sizes] [-e epochs] [-j threads] [-R samples]
+//              [-s seed] < file_list
+//
+// Every parameter takes a comma separated list of values, the grid of all
+// combinations is searched. With -R, that many configurations are instead
+// drawn uniformly between the smallest and the largest value of every list.
+// Configuration i draws its random choices from an engine seeded with
+// seed + i, so a sweep is reproduced by its seed whatever the thread count.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "neural_net.h"
+#include "parser.h"
+#include "resolution.h"
+
+// one point of the search space and its results
+struct sweep_config
+{
+    double lambda;
+    double reward;
+    int steps;
+    double prob_take;
+    int hidden;
+    // seed of the engine behind every random choice of the configuration
+    unsigned int seed;
+    // results
+    int attempts;
+    int proofs;
+    long steps_total;
+    double millis;
+};
+
+// parse a comma separated list of numbers
+std::vector<double> parse_list(const std::string& text)
+{
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        values.push_back(std::stod(item));
+    }
+    if (values.empty()) {
+        throw std::invalid_argument("empty list");
+    }
+    return values;
+}
+
+// all combinations of the listed values
+std::vector<sweep_config> grid_configs(std::vector<std::vector<double> >& space)
+{
+    std::vector<sweep_config> configs;
+    for (double lambda : space[0]) {
+        for (double reward : space[1]) {
+            for (double steps : space[2]) {
+                for (double prob : space[3]) {
+                    for (double hidden : space[4]) {
+                        sweep_config c = {lambda, reward,
+                                          static_cast<int> (steps), prob,
+                                          static_cast<int> (hidden), 0, 0, 0,
+                                          0, 0.0};
+                        configs.push_back(c);
+                    }
+                }
+            }
+        }
+    }
+    return configs;
+}
+
+// configurations drawn uniformly from the ranges spanned by the lists
+std::vector<sweep_config> random_configs(
+    std::vector<std::vector<double> >& space, int samples, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<std::uniform_real_distribution<double> > dists;
+    for (std::vector<double>& values : space) {
+        dists.push_back(std::uniform_real_distribution<double>(
+            *std::min_element(values.begin(), values.end()),
+            *std::max_element(values.begin(), values.end())));
+    }
+    std::vector<sweep_config> configs;
+    for (int i = 0; i < samples; i++) {
+        sweep_config c = {dists[0](rng), dists[1](rng),
+                          static_cast<int> (std::lround(dists[2](rng))),
+                          dists[3](rng),
+                          static_cast<int> (std::lround(dists[4](rng))),
+                          0, 0, 0, 0, 0.0};
+        configs.push_back(c);
+    }
+    return configs;
+}
+
+// train a fresh Q-function estimate with one configuration, every problem is
+// attempted once per epoch. All random choices come from the engine of the
+// configuration, so its results do not depend on the other threads.
+void run_config(sweep_config& config, std::vector<clause_set_t>& problems,
+                int epochs)
+{
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    std::seed_seq seq = {config.seed};
+    std::mt19937 rng(seq);
+    neural_net qfun = res_qlearn::new_qfun(config.hidden, &rng);
+    for (int epoch = 0; epoch < epochs; epoch++) {
+        for (clause_set_t& cs : problems) {
+            res_qlearn algo(cs, qfun, config.steps, config.lambda,
+                            config.reward, config.prob_take, &rng);
+            config.proofs += algo.prove();
+            config.attempts++;
+            config.steps_total += algo.get_steps_taken();
+            algo.learn();
+        }
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    config.millis = elapsed.count();
+}
+
+// worker thread, takes configurations until none are left
+void sweep_worker(std::vector<sweep_config>& configs, std::atomic<size_t>& next,
+                  std::vector<clause_set_t>& problems, int epochs)
+{
+    for (size_t i = next++; i < configs.size(); i = next++) {
+        run_config(configs[i], problems, epochs);
+    }
+}
+
+// better configurations prove more, and with fewer steps
+bool better_config(const sweep_config& a, const sweep_config& b)
+{
+    double rate_a = a.attempts ? double(a.proofs) / a.attempts : 0.0;
+    double rate_b = b.attempts ? double(b.proofs) / b.attempts : 0.0;
+    if (rate_a != rate_b) {
+        return rate_a > rate_b;
+    }
+    return a.steps_total * b.attempts < b.steps_total * a.attempts;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::vector<double> > space(5);
+    space[0] = std::vector<double>(1, 1.0);
+    space[1] = std::vector<double>(1, 1000.0);
+    space[2] = std::vector<double>(1, 100);
+    space[3] = std::vector<double>(1, 0.2);
+    space[4] = std::vector<double>(1, 10);
+    int epochs = 10;
+    int threads = std::thread::hardware_concurrency();
+    int samples = 0;
+    unsigned int seed = 1;
+    int opt;
+    try {
+        while ((opt = getopt(argc, argv, "l:r:n:p:h:e:j:R:s:")) != -1) {
+            switch (opt) {
+                case 'l': space[0] = parse_list(optarg); break;
+                case 'r': space[1] = parse_list(optarg); break;
+                case 'n': space[2] = parse_list(optarg); break;
+                case 'p': space[3] = parse_list(optarg); break;
+                case 'h': space[4] = parse_list(optarg); break;
+                case 'e': epochs = std::atoi(optarg); break;
+                case 'j': threads = std::atoi(optarg); break;
+                case 'R': samples = std::atoi(optarg); break;
+                case 's': seed = std::atoi(optarg); break;
+                default:
+                    std::cerr << "usage: " << argv[0] << " [-l lambdas]"
+                              << " [-r rewards] [-n step_limits]"
+                              << " [-p prob_takes] [-h hidden_sizes]"
+                              << " [-e epochs] [-j threads] [-R samples]"
+                              << " [-s seed] < file_list" << std::endl;
+                    return 1;
+            }
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Invalid parameter list: " << ex.what() << std::endl;
+        return 1;
+    }
+    if (*std::min_element(space[2].begin(), space[2].end()) < 1 ||
+        *std::min_element(space[4].begin(), space[4].end()) < 1) {
+        std::cerr << "Step limits and hidden sizes must be positive"
+                  << std::endl;
+        return 1;
+    }
+    if (threads <= 0) {
+        threads = 1;
+    }
+
+    // every problem is parsed once and shared by all configurations
+    std::vector<clause_set_t> problems;
+    std::string file_name;
+    while (std::getline(std::cin, file_name)) {
+        std::fstream fs(file_name, std::fstream::in);
+        try {
+            problems.push_back(parse_stream(fs));
+        } catch (const std::exception& ex) {
+            std::cerr << file_name << ": " << ex.what() << std::endl;
+        }
+    }
+    if (problems.empty()) {
+        std::cerr << "No problems given" << std::endl;
+        return 1;
+    }
+
+    std::vector<sweep_config> configs = samples > 0
+        ? random_configs(space, samples, seed) : grid_configs(space);
+    for (size_t i = 0; i < configs.size(); i++) {
+        configs[i].seed = seed + i;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; i++) {
+        pool.push_back(std::thread(sweep_worker, std::ref(configs),
+                                   std::ref(next), std::ref(problems), epochs));
+    }
+    for (std::thread& t : pool) {
+        t.join();
+    }
+
+    std::stable_sort(configs.begin(), configs.end(), better_config);
+    std::cout << "lambda\treward\tsteps\tprob\thidden\tproofs\trate"
+              << "\tmean_steps\tms" << std::endl;
+    for (sweep_config& c : configs) {
+        std::cout << c.lambda << "\t" << c.reward << "\t" << c.steps << "\t"
+                  << c.prob_take << "\t" << c.hidden << "\t"
+                  << c.proofs << "/" << c.attempts << "\t"
+                  << std::fixed << std::setprecision(3)
+                  << double(c.proofs) / c.attempts << "\t"
+                  << double(c.steps_total) / c.attempts << "\t"
+                  << c.millis << std::defaultfloat << std::setprecision(6)
+                  << std::endl;
+    }
+    return 0;
+}